@@ -14,6 +14,33 @@
 #include "error.h"
 #include "maths.h"
 #include "types.h"
+#ifdef SEN15901_DRIVER_SMP
+#include <stdatomic.h>
+#endif
+
+/*** SEN15901 macros ***/
+
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+#define SEN15901_WIND_GUST_SAMPLES_NUMBER   (SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS * SEN15901_DRIVER_WIND_GUST_SAMPLES_PER_SECOND)
+#endif
+
+#define SEN15901_WIND_ROSE_SECTORS_NUMBER   16
+#define SEN15901_WIND_DIRECTION_CALIBRATION_LUT_SIZE    1001
+
+#define SEN15901_RAIN_EDGE_TO_UM            279
+
+// Variables written under interrupt and read by the process function.
+#ifdef SEN15901_DRIVER_SMP
+#define SEN15901_SHARED(type)               _Atomic(type)
+#else
+#define SEN15901_SHARED(type)               volatile type
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING
+#define SEN15901_WIND_DIRECTION_SAMPLES_NUMBER  SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING
+#else
+#define SEN15901_WIND_DIRECTION_SAMPLES_NUMBER  1
+#endif
 
 /*** SEN15901 structures ***/
 
@@ -26,8 +53,17 @@ typedef enum {
     SEN15901_SUCCESS = 0,
     SEN15901_ERROR_NULL_PARAMETER,
     SEN15901_ERROR_RESISTOR_DIVIDER_RATIO,
+    SEN15901_ERROR_RAIN_RATE_WINDOW,
+    SEN15901_ERROR_AGGREGATION_LEVEL,
+    SEN15901_ERROR_LOG_BUFFER_SIZE,
+    SEN15901_ERROR_LOG_FULL,
+    SEN15901_ERROR_LOG_DATA,
+    SEN15901_ERROR_PAYLOAD_SIZE,
+    SEN15901_ERROR_SAMPLING_PERIOD,
+    SEN15901_ERROR_WIND_DIRECTION_CALIBRATION,
     // Low level drivers errors.
     SEN15901_ERROR_HW_FUNCTION_NOT_IMPLEMENTED,
+    SEN15901_ERROR_HW_INSTANCE,
     SEN15901_ERROR_BASE_GPIO = ERROR_BASE_STEP,
     SEN15901_ERROR_BASE_TIMER = (SEN15901_ERROR_BASE_GPIO + SEN15901_DRIVER_GPIO_ERROR_BASE_LAST),
     SEN15901_ERROR_BASE_ADC = (SEN15901_ERROR_BASE_TIMER + SEN15901_DRIVER_TIMER_ERROR_BASE_LAST),
@@ -48,22 +84,693 @@ typedef enum {
     SEN15901_WIND_DIRECTION_STATUS_LAST
 } SEN15901_wind_direction_status_t;
 
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+/*!******************************************************************
+ * \enum SEN15901_rain_rate_window_t
+ * \brief SEN15901 driver rain rate sliding windows.
+ *******************************************************************/
+typedef enum {
+    SEN15901_RAIN_RATE_WINDOW_1_MINUTE = 0,
+    SEN15901_RAIN_RATE_WINDOW_10_MINUTES,
+    SEN15901_RAIN_RATE_WINDOW_60_MINUTES,
+    SEN15901_RAIN_RATE_WINDOW_LAST
+} SEN15901_rain_rate_window_t;
+
+/*!******************************************************************
+ * \fn SEN15901_rain_rate_alert_cb_t
+ * \brief Callback called when the 1 minute rain rate exceeds the alert threshold.
+ *******************************************************************/
+typedef void (*SEN15901_rain_rate_alert_cb_t)(int32_t rain_rate_um_h);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION
+/*!******************************************************************
+ * \struct SEN15901_wind_direction_calibration_t
+ * \brief Wind vane resistor divider ratio plateau of each sector.
+ *******************************************************************/
+typedef struct {
+    // Clockwise from north (22.5 degrees sectors), 0 when the nominal ratio is used.
+    uint16_t plateau_permille[SEN15901_WIND_ROSE_SECTORS_NUMBER];
+} SEN15901_wind_direction_calibration_t;
+
+/*!******************************************************************
+ * \fn SEN15901_wind_direction_calibration_store_cb_t
+ * \brief Callback called to save the calibration in non-volatile memory.
+ *******************************************************************/
+typedef SEN15901_status_t (*SEN15901_wind_direction_calibration_store_cb_t)(const SEN15901_wind_direction_calibration_t* calibration);
+
+/*!******************************************************************
+ * \fn SEN15901_wind_direction_calibration_load_cb_t
+ * \brief Callback called to read the calibration from non-volatile memory.
+ *******************************************************************/
+typedef SEN15901_status_t (*SEN15901_wind_direction_calibration_load_cb_t)(SEN15901_wind_direction_calibration_t* calibration);
+#endif
+
+#ifdef SEN15901_DRIVER_AGGREGATION
+/*!******************************************************************
+ * \enum SEN15901_aggregation_level_t
+ * \brief SEN15901 driver cascaded aggregation levels.
+ *******************************************************************/
+typedef enum {
+    SEN15901_AGGREGATION_LEVEL_1_MINUTE = 0,
+    SEN15901_AGGREGATION_LEVEL_10_MINUTES,
+    SEN15901_AGGREGATION_LEVEL_1_HOUR,
+    SEN15901_AGGREGATION_LEVEL_LAST
+} SEN15901_aggregation_level_t;
+#endif
+
+struct SEN15901_context_s;
+
 /*!******************************************************************
  * \fn SEN15901_process_cb_t
  * \brief SEN15901 driver process callback.
+ * \param[in]   context: Pointer to the driver instance context which has to be processed.
+ *******************************************************************/
+typedef void (*SEN15901_process_cb_t)(struct SEN15901_context_s* context);
+
+#ifndef SEN15901_DRIVER_SINGLETON_API_DISABLE
+/*!******************************************************************
+ * \fn SEN15901_singleton_process_cb_t
+ * \brief SEN15901 driver default instance process callback.
+ *******************************************************************/
+typedef void (*SEN15901_singleton_process_cb_t)(void);
+#endif
+
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+/*!******************************************************************
+ * \struct SEN15901_edge_ring_t
+ * \brief Single producer (interrupt) single consumer (process) edge timestamps ring.
+ *******************************************************************/
+typedef struct {
+    SEN15901_SHARED(uint32_t) head;
+    SEN15901_SHARED(uint32_t) tail;
+    SEN15901_SHARED(uint32_t) overflow_count;
+    uint32_t overflow_count_read;
+    SEN15901_SHARED(uint32_t) timestamp_us[SEN15901_DRIVER_EDGE_RING_SIZE];
+} SEN15901_edge_ring_t;
+#endif
+
+/*!******************************************************************
+ * \struct SEN15901_measurements_t
+ * \brief SEN15901 measurements accumulated over a reporting interval.
+ *******************************************************************/
+typedef struct {
+    // Wind speed.
+    uint32_t wind_speed_data_count;
+    uint64_t wind_speed_mh_sum;
+    uint32_t wind_speed_mh_peak;
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    uint32_t wind_gust_edge_sum_max;
+#endif
+#ifdef SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS
+    uint16_t wind_speed_histogram[SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS];
+#endif
+    // Wind direction.
+#ifdef SEN15901_DRIVER_WIND_ROSE
+    uint16_t wind_rose[SEN15901_WIND_ROSE_SECTORS_NUMBER];
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    int64_t wind_direction_trend_point_x;
+    int64_t wind_direction_trend_point_y;
+#else
+    int32_t wind_direction_trend_point_x;
+    int32_t wind_direction_trend_point_y;
+    uint8_t wind_direction_trend_point_shift;
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+    uint32_t wind_direction_data_count;
+    int64_t wind_direction_unit_sum_x;
+    int64_t wind_direction_unit_sum_y;
+#endif
+    // Rainfall.
+    uint32_t rain_edge_count;
+} SEN15901_measurements_t;
+
+/*!******************************************************************
+ * \struct SEN15901_snapshot_t
+ * \brief SEN15901 measurements of a closed reporting interval.
+ *******************************************************************/
+typedef struct {
+    int32_t average_speed_mh;
+    int32_t peak_speed_mh;
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    int32_t gust_speed_mh;
+#endif
+#ifdef SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS
+    uint16_t wind_speed_histogram[SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS];
+#endif
+    int32_t average_direction_degrees;
+    SEN15901_wind_direction_status_t direction_status;
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+    int32_t direction_sigma_degrees;
+#endif
+#ifdef SEN15901_DRIVER_WIND_ROSE
+    uint16_t wind_rose[SEN15901_WIND_ROSE_SECTORS_NUMBER];
+#endif
+    int32_t rainfall_um;
+} SEN15901_snapshot_t;
+
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+/*!******************************************************************
+ * \struct SEN15901_edge_guard_t
+ * \brief Debounce and interrupt storm protection of a reed switch input.
+ *******************************************************************/
+typedef struct {
+    uint32_t debounce_us;
+    uint32_t storm_edge_count_max;
+    uint32_t edge_last_us;
+    uint8_t edge_last_valid;
+    uint8_t interrupt_enable_flag;
+    SEN15901_SHARED(uint8_t) masked_flag;
+    SEN15901_SHARED(uint32_t) tick_edge_count;
+    SEN15901_SHARED(uint32_t) bounce_count;
+    SEN15901_SHARED(uint32_t) storm_count;
+} SEN15901_edge_guard_t;
+
+/*!******************************************************************
+ * \struct SEN15901_edge_guard_events_t
+ * \brief Edges rejected by the debounce and interrupt storms detected on each input.
+ *******************************************************************/
+typedef struct {
+    uint32_t wind_speed_bounce_count;
+    uint32_t wind_speed_storm_count;
+    uint32_t rainfall_bounce_count;
+    uint32_t rainfall_storm_count;
+} SEN15901_edge_guard_events_t;
+#endif
+
+#ifdef SEN15901_DRIVER_ADAPTIVE_SAMPLING
+/*!******************************************************************
+ * \struct SEN15901_adaptive_sampling_t
+ * \brief Wind sampling periods policy (lengthened in stable conditions, shortened on changes).
  *******************************************************************/
-typedef void (*SEN15901_process_cb_t)(void);
+typedef struct {
+    uint8_t wind_speed_period_min_seconds;
+    uint8_t wind_speed_period_max_seconds;
+    uint8_t wind_direction_period_min_seconds;
+    uint8_t wind_direction_period_max_seconds;
+    SEN15901_SHARED(uint8_t) wind_speed_period_seconds;
+    SEN15901_SHARED(uint8_t) wind_direction_period_seconds;
+    uint16_t wind_direction_degrees_last;
+    uint8_t wind_direction_last_valid;
+    uint8_t stable_samples_count;
+} SEN15901_adaptive_sampling_t;
+#endif
+
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+/*!******************************************************************
+ * \struct SEN15901_instrumentation_t
+ * \brief SEN15901 driver interrupts and process function statistics.
+ *******************************************************************/
+typedef struct {
+    uint32_t wind_speed_edge_irq_count;
+    uint32_t rainfall_edge_irq_count;
+    uint32_t tick_second_irq_count;
+    uint32_t tick_gust_irq_count;
+    uint32_t adc_done_irq_count;
+    uint32_t wind_speed_edge_rate_max;
+    uint32_t rainfall_edge_rate_max;
+    uint32_t process_call_count;
+    uint32_t process_cycles_min;
+    uint32_t process_cycles_max;
+    uint64_t process_cycles_total;
+} SEN15901_instrumentation_t;
+#endif
+
+/*!******************************************************************
+ * \struct SEN15901_context_t
+ * \brief SEN15901 driver instance context (allocated by the caller).
+ *******************************************************************/
+typedef struct SEN15901_context_s {
+    // State machine.
+    SEN15901_process_cb_t process_callback;
+    SEN15901_SHARED(uint8_t) tick_second_flag;
+    uint8_t wind_measurement_enable_flag;
+#ifdef SEN15901_DRIVER_TICKLESS
+    SEN15901_SHARED(uint8_t) wakeup_delay_seconds;
+#endif
+    // Wind speed.
+    SEN15901_SHARED(uint8_t) wind_speed_seconds_count;
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+    SEN15901_edge_ring_t wind_speed_edge_ring;
+#else
+    SEN15901_SHARED(uint32_t) wind_speed_edge_count;
+    uint32_t wind_speed_edge_count_read;
+#endif
+    uint32_t wind_speed_mh_last;
+#ifdef SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT
+    uint32_t wind_speed_edge_last_us;
+    uint8_t wind_speed_edge_last_valid;
+    uint32_t wind_speed_period_mh;
+#endif
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    // Wind gust (sliding window written under interrupt).
+    uint16_t wind_gust_edge_count[SEN15901_WIND_GUST_SAMPLES_NUMBER];
+    uint8_t wind_gust_sample_index;
+    uint8_t wind_gust_samples_count;
+    uint32_t wind_gust_edge_count_read;
+    uint32_t wind_gust_edge_sum;
+    SEN15901_SHARED(uint32_t) wind_gust_edge_sum_max_current;
+    SEN15901_SHARED(uint32_t) wind_gust_edge_sum_max_published;
+    SEN15901_SHARED(uint8_t) wind_gust_request;
+    SEN15901_SHARED(uint32_t) wind_gust_edge_sum_max_closed;
+    SEN15901_SHARED(uint8_t) wind_gust_restart_flag;
+#endif
+    // Wind direction.
+    SEN15901_SHARED(uint8_t) wind_direction_seconds_count;
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+    uint8_t wind_direction_adc_pending_flag;
+    SEN15901_SHARED(uint8_t) wind_direction_adc_done_flag;
+    int32_t wind_direction_adc_ratio_permille[SEN15901_WIND_DIRECTION_SAMPLES_NUMBER];
+    uint32_t wind_direction_adc_wind_speed_mh;
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING
+    uint32_t wind_direction_rejected_count;
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION
+    // Wind vane plateaus being set, last applied plateaus and ratio to direction table built from them.
+    SEN15901_wind_direction_calibration_t wind_direction_calibration;
+    SEN15901_wind_direction_calibration_t wind_direction_calibration_applied;
+    uint8_t wind_direction_lut[SEN15901_WIND_DIRECTION_CALIBRATION_LUT_SIZE];
+    uint8_t wind_direction_lut_valid_flag;
+    uint8_t wind_direction_learning_flag;
+    uint32_t wind_direction_learning_sum[SEN15901_WIND_ROSE_SECTORS_NUMBER];
+    uint16_t wind_direction_learning_count[SEN15901_WIND_ROSE_SECTORS_NUMBER];
+    SEN15901_wind_direction_calibration_store_cb_t wind_direction_calibration_store_callback;
+#endif
+    // Rainfall.
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+    SEN15901_edge_ring_t rain_edge_ring;
+#else
+    SEN15901_SHARED(uint32_t) rain_edge_count;
+    uint32_t rain_edge_count_read;
+#endif
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+    SEN15901_SHARED(uint32_t) rain_rate_clock_seconds;
+    SEN15901_SHARED(uint32_t) rain_tip_seconds[SEN15901_DRIVER_RAIN_RATE_RING_SIZE];
+    SEN15901_SHARED(uint32_t) rain_tip_head;
+    uint32_t rain_tip_head_read;
+    uint32_t rain_tip_window_tail[SEN15901_RAIN_RATE_WINDOW_LAST];
+#ifdef SEN15901_DRIVER_TICKLESS
+    // Next tip expiry published by the process function for the wake-up timer.
+    SEN15901_SHARED(uint32_t) rain_rate_deadline_seconds;
+    SEN15901_SHARED(uint32_t) rain_rate_deadline_tip_head;
+    SEN15901_SHARED(uint8_t) rain_rate_deadline_flag;
+#endif
+    int32_t rain_rate_alert_threshold_um_h;
+    SEN15901_rain_rate_alert_cb_t rain_rate_alert_callback;
+    uint8_t rain_rate_alert_flag;
+#endif
+#ifdef SEN15901_DRIVER_AGGREGATION
+    // Cascaded aggregation (each level is filled by its child level).
+    SEN15901_SHARED(uint32_t) aggregation_clock_seconds;
+    uint32_t aggregation_clock_seconds_read;
+    uint8_t aggregation_children_count[SEN15901_AGGREGATION_LEVEL_LAST - 1];
+    SEN15901_measurements_t aggregation_current[SEN15901_AGGREGATION_LEVEL_LAST];
+    SEN15901_measurements_t aggregation_completed[SEN15901_AGGREGATION_LEVEL_LAST];
+#endif
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+    // Edges filtering (updated under interrupt).
+    SEN15901_edge_guard_t wind_speed_edge_guard;
+    SEN15901_edge_guard_t rain_edge_guard;
+#endif
+#ifdef SEN15901_DRIVER_ADAPTIVE_SAMPLING
+    // Wind sampling periods (read under interrupt in tickless mode).
+    SEN15901_adaptive_sampling_t adaptive_sampling;
+#endif
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+    // Instrumentation (interrupts counters are incremented on any core, process statistics are written under the write sequence).
+    SEN15901_SHARED(uint32_t) instrumentation_wind_speed_edge_irq_count;
+    SEN15901_SHARED(uint32_t) instrumentation_rainfall_edge_irq_count;
+    SEN15901_SHARED(uint32_t) instrumentation_tick_second_irq_count;
+    SEN15901_SHARED(uint32_t) instrumentation_tick_gust_irq_count;
+    SEN15901_SHARED(uint32_t) instrumentation_adc_done_irq_count;
+    SEN15901_SHARED(uint32_t) instrumentation_wind_speed_edge_rate_max;
+    SEN15901_SHARED(uint32_t) instrumentation_rainfall_edge_rate_max;
+    SEN15901_SHARED(uint32_t) instrumentation_wind_speed_edge_second_count;
+    SEN15901_SHARED(uint32_t) instrumentation_rainfall_edge_second_count;
+    uint32_t instrumentation_process_call_count;
+    uint32_t instrumentation_process_cycles_min;
+    uint32_t instrumentation_process_cycles_max;
+    uint64_t instrumentation_process_cycles_total;
+    uint32_t instrumentation_process_cycle_start;
+    uint8_t instrumentation_process_cycle_valid;
+#endif
+    // Measurements banks (active one is filled by the process function).
+    SEN15901_measurements_t measurements_bank[2];
+    SEN15901_measurements_t* measurements;
+#ifdef SEN15901_DRIVER_SMP
+    // Writers lock and sequence counter of the measurements (odd while they are updated).
+    atomic_flag write_lock;
+    SEN15901_SHARED(uint32_t) write_sequence;
+#endif
+} SEN15901_context_t;
 
 /*** SEN15901 functions ***/
 
 /*!******************************************************************
- * \fn SEN15901_status_t SEN15901_init(SEN15901_process_cb_t process_callback)
+ * \fn SEN15901_status_t SEN15901_instance_init(SEN15901_context_t* context, uint8_t hw_instance, SEN15901_process_cb_t process_callback)
+ * \brief Init a SEN15901 driver instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[in]   hw_instance: Hardware instance index forwarded to the hardware interface.
+ * \param[in]   process_callback: Function which will be called when the instance has to be processed.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_init(SEN15901_context_t* context, uint8_t hw_instance, SEN15901_process_cb_t process_callback);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_de_init(SEN15901_context_t* context)
+ * \brief Release a SEN15901 driver instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_de_init(SEN15901_context_t* context);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_set_wind_measurement(SEN15901_context_t* context, uint8_t enable)
+ * \brief Control wind speed and direction measurements of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[in]   enable: Disable (0) or enable (otherwise) wind speed and direction measurements.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_set_wind_measurement(SEN15901_context_t* context, uint8_t enable);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_set_rainfall_measurement(SEN15901_context_t* context, uint8_t enable)
+ * \brief Control rainfall measurement of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[in]   enable: Disable (0) or enable (otherwise) rainfall measurement.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_set_rainfall_measurement(SEN15901_context_t* context, uint8_t enable);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_process(SEN15901_context_t* context)
+ * \brief SEN15901 driver instance process function.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_process(SEN15901_context_t* context);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_wind_speed(SEN15901_context_t* context, int32_t* average_speed_mh, int32_t* peak_speed_mh)
+ * \brief Read wind speeds of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  average_speed_mh: Pointer to integer that will contain the average wind speed since last reset in m/h.
+ * \param[out]  peak_speed_mh: Pointer to integer that will contain the peak wind speed since last reset in m/h.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_speed(SEN15901_context_t* context, int32_t* average_speed_mh, int32_t* peak_speed_mh);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_wind_direction(SEN15901_context_t* context, int32_t* average_direction_degrees, SEN15901_wind_direction_status_t* direction_status)
+ * \brief Read wind average direction of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  average_direction_degrees: Pointer to integer that will contain the average wind direction since last reset in degrees.
+ * \param[out]  direction_status: Status of the output data.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_direction(SEN15901_context_t* context, int32_t* average_direction_degrees, SEN15901_wind_direction_status_t* direction_status);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_rainfall(SEN15901_context_t* context, int32_t* rainfall_um)
+ * \brief Read rainfall of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  rainfall_um: Pointer to integer that will contain the rainfall count in micrometer.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_rainfall(SEN15901_context_t* context, int32_t* rainfall_um);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_reset_measurements(SEN15901_context_t* context)
+ * \brief Reset wind and rainfall measurements of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_reset_measurements(SEN15901_context_t* context);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_snapshot(SEN15901_context_t* context, SEN15901_snapshot_t* snapshot)
+ * \brief Read all measurements of an instance and start a new interval without losing any sample.
+ * \brief Must be called from the same execution context as the process function.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  snapshot: Pointer to the structure that will contain the measurements since last reset or snapshot.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_snapshot(SEN15901_context_t* context, SEN15901_snapshot_t* snapshot);
+
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_wind_gust(SEN15901_context_t* context, int32_t* gust_speed_mh)
+ * \brief Read wind gust of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  gust_speed_mh: Pointer to integer that will contain the maximum running mean wind speed over SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS since last reset in m/h.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_gust(SEN15901_context_t* context, int32_t* gust_speed_mh);
+#endif
+
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_edge_ring_overflow(SEN15901_context_t* context, uint32_t* wind_speed_overflow_count, uint32_t* rainfall_overflow_count)
+ * \brief Read the number of edges which could not be timestamped because the ring was full.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  wind_speed_overflow_count: Pointer to integer that will contain the wind speed ring overflow count since init.
+ * \param[out]  rainfall_overflow_count: Pointer to integer that will contain the rainfall ring overflow count since init.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_edge_ring_overflow(SEN15901_context_t* context, uint32_t* wind_speed_overflow_count, uint32_t* rainfall_overflow_count);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_wind_direction_rejected_count(SEN15901_context_t* context, uint32_t* rejected_count)
+ * \brief Read the number of wind direction samples rejected by the oversampling vote.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  rejected_count: Pointer to integer that will contain the number of out of range ratios since init.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_direction_rejected_count(SEN15901_context_t* context, uint32_t* rejected_count);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_ROSE
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_wind_rose(SEN15901_context_t* context, uint16_t* wind_rose)
+ * \brief Read the wind direction distribution of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  wind_rose: Array of SEN15901_WIND_ROSE_SECTORS_NUMBER elements that will contain the number of direction samples of each sector since last reset (clockwise from north, 22.5 degrees sectors, saturated at 65535).
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_rose(SEN15901_context_t* context, uint16_t* wind_rose);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_wind_speed_histogram(SEN15901_context_t* context, uint16_t* wind_speed_histogram)
+ * \brief Read the wind speed distribution of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  wind_speed_histogram: Array of SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS elements that will contain the number of speed samples of each bin since last reset (saturated at 65535).
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_speed_histogram(SEN15901_context_t* context, uint16_t* wind_speed_histogram);
+#endif
+
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_rain_rate(SEN15901_context_t* context, SEN15901_rain_rate_window_t window, int32_t* rain_rate_um_h)
+ * \brief Read rainfall intensity of an instance over a sliding window.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[in]   window: Sliding window length.
+ * \param[out]  rain_rate_um_h: Pointer to integer that will contain the rain rate in micrometers per hour.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_rain_rate(SEN15901_context_t* context, SEN15901_rain_rate_window_t window, int32_t* rain_rate_um_h);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_set_rain_rate_alert(SEN15901_context_t* context, int32_t threshold_um_h, SEN15901_rain_rate_alert_cb_t alert_callback)
+ * \brief Configure the intense rain alert of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[in]   threshold_um_h: 1 minute rain rate above which the callback is called, in micrometers per hour.
+ * \param[in]   alert_callback: Function called by the process function when the threshold is crossed, NULL to disable the alert.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_set_rain_rate_alert(SEN15901_context_t* context, int32_t threshold_um_h, SEN15901_rain_rate_alert_cb_t alert_callback);
+#endif
+
+#ifdef SEN15901_DRIVER_AGGREGATION
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_aggregate(SEN15901_context_t* context, SEN15901_aggregation_level_t level, SEN15901_snapshot_t* snapshot)
+ * \brief Read the last completed interval of an aggregation level.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[in]   level: Aggregation level to read.
+ * \param[out]  snapshot: Pointer to the structure that will contain the measurements of the interval (all zero until the first interval is completed).
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_aggregate(SEN15901_context_t* context, SEN15901_aggregation_level_t level, SEN15901_snapshot_t* snapshot);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_wind_direction_sigma(SEN15901_context_t* context, int32_t* sigma_degrees, SEN15901_wind_direction_status_t* direction_status)
+ * \brief Read wind direction standard deviation of an instance (Yamartino estimator).
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  sigma_degrees: Pointer to integer that will contain the wind direction standard deviation since last reset in degrees.
+ * \param[out]  direction_status: Status of the output data.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_direction_sigma(SEN15901_context_t* context, int32_t* sigma_degrees, SEN15901_wind_direction_status_t* direction_status);
+#endif
+
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_instrumentation(SEN15901_context_t* context, SEN15901_instrumentation_t* instrumentation)
+ * \brief Read interrupts counts, maximum edge rates (per second) and process function durations (in SEN15901_HW_get_cycle_count() units) of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  instrumentation: Pointer to the structure that will contain the statistics since last reset.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_instrumentation(SEN15901_context_t* context, SEN15901_instrumentation_t* instrumentation);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_reset_instrumentation(SEN15901_context_t* context)
+ * \brief Reset instrumentation statistics of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_reset_instrumentation(SEN15901_context_t* context);
+#endif
+
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_set_debounce(SEN15901_context_t* context, uint32_t wind_speed_debounce_us, uint32_t rainfall_debounce_us)
+ * \brief Set the minimum interval between two valid edges of each input of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[in]   wind_speed_debounce_us: Anemometer minimum edges interval in microseconds (0 to disable debounce and storm protection).
+ * \param[in]   rainfall_debounce_us: Rain gauge minimum edges interval in microseconds (0 to disable debounce and storm protection).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_set_debounce(SEN15901_context_t* context, uint32_t wind_speed_debounce_us, uint32_t rainfall_debounce_us);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_edge_guard_events(SEN15901_context_t* context, SEN15901_edge_guard_events_t* events)
+ * \brief Read the number of bounces rejected and interrupt storms detected on each input of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  events: Pointer to the structure that will contain the counters since init.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_edge_guard_events(SEN15901_context_t* context, SEN15901_edge_guard_events_t* events);
+#endif
+
+#ifdef SEN15901_DRIVER_ADAPTIVE_SAMPLING
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_set_adaptive_sampling(SEN15901_context_t* context, uint8_t wind_speed_period_min_seconds, uint8_t wind_speed_period_max_seconds, uint8_t wind_direction_period_min_seconds, uint8_t wind_direction_period_max_seconds)
+ * \brief Set the wind sampling periods range of an instance (periods restart from their minimum).
+ * \param[in]   context: Pointer to the instance context.
+ * \param[in]   wind_speed_period_min_seconds: Wind speed sampling window used when conditions change.
+ * \param[in]   wind_speed_period_max_seconds: Longest wind speed sampling window in stable conditions.
+ * \param[in]   wind_direction_period_min_seconds: Wind direction sampling period used when conditions change.
+ * \param[in]   wind_direction_period_max_seconds: Longest wind direction sampling period in stable conditions.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_set_adaptive_sampling(SEN15901_context_t* context, uint8_t wind_speed_period_min_seconds, uint8_t wind_speed_period_max_seconds, uint8_t wind_direction_period_min_seconds, uint8_t wind_direction_period_max_seconds);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_sampling_periods(SEN15901_context_t* context, uint8_t* wind_speed_period_seconds, uint8_t* wind_direction_period_seconds)
+ * \brief Read the current wind sampling periods of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  wind_speed_period_seconds: Pointer to the current wind speed sampling window in seconds.
+ * \param[out]  wind_direction_period_seconds: Pointer to the current wind direction sampling period in seconds.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_sampling_periods(SEN15901_context_t* context, uint8_t* wind_speed_period_seconds, uint8_t* wind_direction_period_seconds);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_set_wind_direction_plateau(SEN15901_context_t* context, uint8_t sector, uint16_t plateau_permille)
+ * \brief Set the resistor divider ratio plateau of a wind vane sector of an instance (taken into account by the next apply function call).
+ * \param[in]   context: Pointer to the instance context.
+ * \param[in]   sector: Sector index, clockwise from north (22.5 degrees sectors).
+ * \param[in]   plateau_permille: Measured ratio of the sector in per-mille, 0 to use the nominal value.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_set_wind_direction_plateau(SEN15901_context_t* context, uint8_t sector, uint16_t plateau_permille);
+
+#ifndef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_calibrate_wind_direction_sector(SEN15901_context_t* context, uint8_t sector)
+ * \brief Guided rotation step of an instance: measure the ratio while the vane is held in a known sector and set it as plateau.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[in]   sector: Sector index where the vane is currently held, clockwise from north (22.5 degrees sectors).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_calibrate_wind_direction_sector(SEN15901_context_t* context, uint8_t sector);
+#endif
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_set_wind_direction_learning(SEN15901_context_t* context, uint8_t enable)
+ * \brief Start or stop the learning of the plateaus from the field samples of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[in]   enable: 1 to reset the statistics and start learning, 0 to stop and update the plateaus of the sectors with enough samples.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_set_wind_direction_learning(SEN15901_context_t* context, uint8_t enable);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_apply_wind_direction_calibration(SEN15901_context_t* context)
+ * \brief Rebuild the ratio to direction table from the current plateaus of an instance and save them with the store callback.
+ * \brief When the plateaus are not sorted or no sector is calibrated, an error is returned and the plateaus are restored to the last applied calibration.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_apply_wind_direction_calibration(SEN15901_context_t* context);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_set_wind_direction_calibration_callbacks(SEN15901_context_t* context, SEN15901_wind_direction_calibration_store_cb_t store_callback, SEN15901_wind_direction_calibration_load_cb_t load_callback)
+ * \brief Set the non-volatile storage callbacks of the calibration of an instance and load the saved calibration.
+ * \brief The current calibration is kept when the loaded plateaus are not sorted or no sector is calibrated.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[in]   store_callback: Function called after each applied calibration (can be NULL).
+ * \param[in]   load_callback: Function called immediately to restore the saved calibration (can be NULL).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_set_wind_direction_calibration_callbacks(SEN15901_context_t* context, SEN15901_wind_direction_calibration_store_cb_t store_callback, SEN15901_wind_direction_calibration_load_cb_t load_callback);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_instance_get_wind_direction_calibration(SEN15901_context_t* context, SEN15901_wind_direction_calibration_t* calibration)
+ * \brief Read the current plateaus of an instance.
+ * \param[in]   context: Pointer to the instance context.
+ * \param[out]  calibration: Pointer to the structure that will contain the plateau of each sector (0 for nominal).
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_direction_calibration(SEN15901_context_t* context, SEN15901_wind_direction_calibration_t* calibration);
+#endif
+
+#ifndef SEN15901_DRIVER_SINGLETON_API_DISABLE
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_init(SEN15901_singleton_process_cb_t process_callback)
  * \brief Init SEN15901 driver.
  * \param[in]   process_callback: Function which will be called when the SEN15901 driver has to be processed.
  * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
-SEN15901_status_t SEN15901_init(SEN15901_process_cb_t process_callback);
+SEN15901_status_t SEN15901_init(SEN15901_singleton_process_cb_t process_callback);
 
 /*!******************************************************************
  * \fn SEN15901_status_t SEN15901_de_init(void)
@@ -139,6 +846,245 @@ SEN15901_status_t SEN15901_get_rainfall(int32_t* rainfall_um);
  *******************************************************************/
 void SEN15901_reset_measurements(void);
 
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_snapshot(SEN15901_snapshot_t* snapshot)
+ * \brief Read all measurements and start a new interval without losing any sample.
+ * \brief Must be called from the same execution context as the process function.
+ * \param[in]   none
+ * \param[out]  snapshot: Pointer to the structure that will contain the measurements since last reset or snapshot.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_snapshot(SEN15901_snapshot_t* snapshot);
+
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_get_wind_gust(int32_t* gust_speed_mh)
+ * \brief Read wind gust.
+ * \param[in]   none
+ * \param[out]  gust_speed_mh: Pointer to integer that will contain the maximum running mean wind speed over SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS since last reset in m/h.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_get_wind_gust(int32_t* gust_speed_mh);
+#endif
+
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_get_edge_ring_overflow(uint32_t* wind_speed_overflow_count, uint32_t* rainfall_overflow_count)
+ * \brief Read the number of edges which could not be timestamped because the ring was full.
+ * \param[in]   none
+ * \param[out]  wind_speed_overflow_count: Pointer to integer that will contain the wind speed ring overflow count since init.
+ * \param[out]  rainfall_overflow_count: Pointer to integer that will contain the rainfall ring overflow count since init.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_get_edge_ring_overflow(uint32_t* wind_speed_overflow_count, uint32_t* rainfall_overflow_count);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_get_wind_direction_rejected_count(uint32_t* rejected_count)
+ * \brief Read the number of wind direction samples rejected by the oversampling vote.
+ * \param[in]   none
+ * \param[out]  rejected_count: Pointer to integer that will contain the number of out of range ratios since init.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_get_wind_direction_rejected_count(uint32_t* rejected_count);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_ROSE
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_get_wind_rose(uint16_t* wind_rose)
+ * \brief Read the wind direction distribution.
+ * \param[in]   none
+ * \param[out]  wind_rose: Array of SEN15901_WIND_ROSE_SECTORS_NUMBER elements that will contain the number of direction samples of each sector since last reset (clockwise from north, 22.5 degrees sectors, saturated at 65535).
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_get_wind_rose(uint16_t* wind_rose);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_get_wind_speed_histogram(uint16_t* wind_speed_histogram)
+ * \brief Read the wind speed distribution.
+ * \param[in]   none
+ * \param[out]  wind_speed_histogram: Array of SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS elements that will contain the number of speed samples of each bin since last reset (saturated at 65535).
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_get_wind_speed_histogram(uint16_t* wind_speed_histogram);
+#endif
+
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_get_rain_rate(SEN15901_rain_rate_window_t window, int32_t* rain_rate_um_h)
+ * \brief Read rainfall intensity over a sliding window.
+ * \param[in]   window: Sliding window length.
+ * \param[out]  rain_rate_um_h: Pointer to integer that will contain the rain rate in micrometers per hour.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_get_rain_rate(SEN15901_rain_rate_window_t window, int32_t* rain_rate_um_h);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_set_rain_rate_alert(int32_t threshold_um_h, SEN15901_rain_rate_alert_cb_t alert_callback)
+ * \brief Configure the intense rain alert.
+ * \param[in]   threshold_um_h: 1 minute rain rate above which the callback is called, in micrometers per hour.
+ * \param[in]   alert_callback: Function called by the process function when the threshold is crossed, NULL to disable the alert.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_set_rain_rate_alert(int32_t threshold_um_h, SEN15901_rain_rate_alert_cb_t alert_callback);
+#endif
+
+#ifdef SEN15901_DRIVER_AGGREGATION
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_get_aggregate(SEN15901_aggregation_level_t level, SEN15901_snapshot_t* snapshot)
+ * \brief Read the last completed interval of an aggregation level.
+ * \param[in]   level: Aggregation level to read.
+ * \param[out]  snapshot: Pointer to the structure that will contain the measurements of the interval (all zero until the first interval is completed).
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_get_aggregate(SEN15901_aggregation_level_t level, SEN15901_snapshot_t* snapshot);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_get_wind_direction_sigma(int32_t* sigma_degrees, SEN15901_wind_direction_status_t* direction_status)
+ * \brief Read wind direction standard deviation (Yamartino estimator).
+ * \param[in]   none
+ * \param[out]  sigma_degrees: Pointer to integer that will contain the wind direction standard deviation since last reset in degrees.
+ * \param[out]  direction_status: Status of the output data.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_get_wind_direction_sigma(int32_t* sigma_degrees, SEN15901_wind_direction_status_t* direction_status);
+#endif
+
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_get_instrumentation(SEN15901_instrumentation_t* instrumentation)
+ * \brief Read interrupts counts, maximum edge rates (per second) and process function durations (in SEN15901_HW_get_cycle_count() units).
+ * \param[in]   none
+ * \param[out]  instrumentation: Pointer to the structure that will contain the statistics since last reset.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_get_instrumentation(SEN15901_instrumentation_t* instrumentation);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_reset_instrumentation(void)
+ * \brief Reset instrumentation statistics.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_reset_instrumentation(void);
+#endif
+
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_set_debounce(uint32_t wind_speed_debounce_us, uint32_t rainfall_debounce_us)
+ * \brief Set the minimum interval between two valid edges of each input.
+ * \param[in]   wind_speed_debounce_us: Anemometer minimum edges interval in microseconds (0 to disable debounce and storm protection).
+ * \param[in]   rainfall_debounce_us: Rain gauge minimum edges interval in microseconds (0 to disable debounce and storm protection).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_set_debounce(uint32_t wind_speed_debounce_us, uint32_t rainfall_debounce_us);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_get_edge_guard_events(SEN15901_edge_guard_events_t* events)
+ * \brief Read the number of bounces rejected and interrupt storms detected on each input.
+ * \param[in]   none
+ * \param[out]  events: Pointer to the structure that will contain the counters since init.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_get_edge_guard_events(SEN15901_edge_guard_events_t* events);
+#endif
+
+#ifdef SEN15901_DRIVER_ADAPTIVE_SAMPLING
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_set_adaptive_sampling(uint8_t wind_speed_period_min_seconds, uint8_t wind_speed_period_max_seconds, uint8_t wind_direction_period_min_seconds, uint8_t wind_direction_period_max_seconds)
+ * \brief Set the wind sampling periods range (periods restart from their minimum).
+ * \param[in]   wind_speed_period_min_seconds: Wind speed sampling window used when conditions change.
+ * \param[in]   wind_speed_period_max_seconds: Longest wind speed sampling window in stable conditions.
+ * \param[in]   wind_direction_period_min_seconds: Wind direction sampling period used when conditions change.
+ * \param[in]   wind_direction_period_max_seconds: Longest wind direction sampling period in stable conditions.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_set_adaptive_sampling(uint8_t wind_speed_period_min_seconds, uint8_t wind_speed_period_max_seconds, uint8_t wind_direction_period_min_seconds, uint8_t wind_direction_period_max_seconds);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_get_sampling_periods(uint8_t* wind_speed_period_seconds, uint8_t* wind_direction_period_seconds)
+ * \brief Read the current wind sampling periods.
+ * \param[in]   none
+ * \param[out]  wind_speed_period_seconds: Pointer to the current wind speed sampling window in seconds.
+ * \param[out]  wind_direction_period_seconds: Pointer to the current wind direction sampling period in seconds.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_get_sampling_periods(uint8_t* wind_speed_period_seconds, uint8_t* wind_direction_period_seconds);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_set_wind_direction_plateau(uint8_t sector, uint16_t plateau_permille)
+ * \brief Set the resistor divider ratio plateau of a wind vane sector (taken into account by the next apply function call).
+ * \param[in]   sector: Sector index, clockwise from north (22.5 degrees sectors).
+ * \param[in]   plateau_permille: Measured ratio of the sector in per-mille, 0 to use the nominal value.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_set_wind_direction_plateau(uint8_t sector, uint16_t plateau_permille);
+
+#ifndef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_calibrate_wind_direction_sector(uint8_t sector)
+ * \brief Guided rotation step: measure the ratio while the vane is held in a known sector and set it as plateau.
+ * \param[in]   sector: Sector index where the vane is currently held, clockwise from north (22.5 degrees sectors).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_calibrate_wind_direction_sector(uint8_t sector);
+#endif
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_set_wind_direction_learning(uint8_t enable)
+ * \brief Start or stop the learning of the plateaus from the field samples.
+ * \param[in]   enable: 1 to reset the statistics and start learning, 0 to stop and update the plateaus of the sectors with enough samples.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_set_wind_direction_learning(uint8_t enable);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_apply_wind_direction_calibration(void)
+ * \brief Rebuild the ratio to direction table from the current plateaus and save them with the store callback.
+ * \brief When the plateaus are not sorted or no sector is calibrated, an error is returned and the plateaus are restored to the last applied calibration.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_apply_wind_direction_calibration(void);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_set_wind_direction_calibration_callbacks(SEN15901_wind_direction_calibration_store_cb_t store_callback, SEN15901_wind_direction_calibration_load_cb_t load_callback)
+ * \brief Set the non-volatile storage callbacks of the calibration and load the saved calibration.
+ * \brief The current calibration is kept when the loaded plateaus are not sorted or no sector is calibrated.
+ * \param[in]   store_callback: Function called after each applied calibration (can be NULL).
+ * \param[in]   load_callback: Function called immediately to restore the saved calibration (can be NULL).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_set_wind_direction_calibration_callbacks(SEN15901_wind_direction_calibration_store_cb_t store_callback, SEN15901_wind_direction_calibration_load_cb_t load_callback);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_get_wind_direction_calibration(SEN15901_wind_direction_calibration_t* calibration)
+ * \brief Read the current plateaus.
+ * \param[in]   none
+ * \param[out]  calibration: Pointer to the structure that will contain the plateau of each sector (0 for nominal).
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_get_wind_direction_calibration(SEN15901_wind_direction_calibration_t* calibration);
+#endif
+
+#endif /* SEN15901_DRIVER_SINGLETON_API_DISABLE */
+
 /*******************************************************************/
 #define SEN15901_exit_error(base) { ERROR_check_exit(sen15901_status, SEN15901_SUCCESS, base) }
 
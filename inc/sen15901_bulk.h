@@ -0,0 +1,111 @@
+/*
+ * sen15901_bulk.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SEN15901_BULK_H__
+#define __SEN15901_BULK_H__
+
+#ifndef SEN15901_DRIVER_DISABLE_FLAGS_FILE
+#include "sen15901_driver_flags.h"
+#endif
+#include "sen15901.h"
+#include "types.h"
+
+#if (!(defined SEN15901_DRIVER_DISABLE) && (defined SEN15901_DRIVER_BULK))
+
+/*** SEN15901 BULK macros ***/
+
+#define SEN15901_BULK_WIND_DIRECTIONS_NUMBER            16
+#define SEN15901_BULK_WIND_DIRECTION_INDEX_ERROR        0xFF
+#define SEN15901_BULK_WIND_DIRECTION_DEGREES_ERROR      (-1)
+
+/*** SEN15901 BULK structures ***/
+
+/*!******************************************************************
+ * \struct SEN15901_BULK_trend_t
+ * \brief Wind direction trend point accumulator (same arithmetic as the driver measurements banks).
+ *******************************************************************/
+typedef struct {
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    int64_t trend_point_x;
+    int64_t trend_point_y;
+#else
+    int32_t trend_point_x;
+    int32_t trend_point_y;
+    uint8_t trend_point_shift;
+#endif
+    // Unit vector of each direction index (last entry is the null vector of invalid samples).
+    int32_t direction_x[SEN15901_BULK_WIND_DIRECTIONS_NUMBER + 1];
+    int32_t direction_y[SEN15901_BULK_WIND_DIRECTIONS_NUMBER + 1];
+} SEN15901_BULK_trend_t;
+
+/*** SEN15901 BULK functions ***/
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_BULK_get_wind_speed(const uint32_t* wind_speed_edge_count, uint32_t* wind_speed_mh, uint32_t samples_number)
+ * \brief Convert anemometer edge counts of sampling windows to wind speeds.
+ * \param[in]   wind_speed_edge_count: Number of edges counted during each SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS window.
+ * \param[in]   samples_number: Number of samples of the arrays.
+ * \param[out]  wind_speed_mh: Wind speed of each sample in m/h.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_BULK_get_wind_speed(const uint32_t* wind_speed_edge_count, uint32_t* wind_speed_mh, uint32_t samples_number);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_BULK_get_rainfall(const uint32_t* rain_edge_count, int32_t* rainfall_um, uint32_t samples_number)
+ * \brief Convert rain gauge edge counts to rainfalls.
+ * \param[in]   rain_edge_count: Number of rain gauge tips of each sample.
+ * \param[in]   samples_number: Number of samples of the arrays.
+ * \param[out]  rainfall_um: Rainfall of each sample in micrometers.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_BULK_get_rainfall(const uint32_t* rain_edge_count, int32_t* rainfall_um, uint32_t samples_number);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_BULK_get_wind_direction(const int32_t* wind_direction_ratio_permille, uint8_t* wind_direction_index, int32_t* wind_direction_degrees, uint32_t samples_number)
+ * \brief Convert wind vane resistor divider ratios to direction indexes and angles.
+ * \param[in]   wind_direction_ratio_permille: Wind direction analog input ratio of each sample in per-mille.
+ * \param[in]   samples_number: Number of samples of the arrays.
+ * \param[out]  wind_direction_index: Direction index of each sample (SEN15901_BULK_WIND_DIRECTION_INDEX_ERROR if the ratio is out of range).
+ * \param[out]  wind_direction_degrees: Optional direction angle of each sample (SEN15901_BULK_WIND_DIRECTION_DEGREES_ERROR if the ratio is out of range), can be NULL.
+ * \retval      Function execution status (SEN15901_ERROR_RESISTOR_DIVIDER_RATIO if at least one ratio is out of range, all samples are converted anyway).
+ *******************************************************************/
+SEN15901_status_t SEN15901_BULK_get_wind_direction(const int32_t* wind_direction_ratio_permille, uint8_t* wind_direction_index, int32_t* wind_direction_degrees, uint32_t samples_number);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_BULK_trend_init(SEN15901_BULK_trend_t* trend)
+ * \brief Reset a wind direction trend point accumulator.
+ * \param[in]   trend: Pointer to the accumulator.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_BULK_trend_init(SEN15901_BULK_trend_t* trend);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_BULK_trend_add(SEN15901_BULK_trend_t* trend, const uint32_t* wind_speed_mh, const uint8_t* wind_direction_index, uint32_t samples_number)
+ * \brief Add the speed weighted direction vectors of a batch of samples, in order.
+ * \param[in]   trend: Pointer to the accumulator.
+ * \param[in]   wind_speed_mh: Wind speed of each sample in m/h.
+ * \param[in]   wind_direction_index: Direction index of each sample (samples with an invalid index are skipped).
+ * \param[in]   samples_number: Number of samples of the arrays.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_BULK_trend_add(SEN15901_BULK_trend_t* trend, const uint32_t* wind_speed_mh, const uint8_t* wind_direction_index, uint32_t samples_number);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_BULK_trend_get_direction(SEN15901_BULK_trend_t* trend, int32_t* average_direction_degrees, SEN15901_wind_direction_status_t* direction_status)
+ * \brief Compute the average wind direction of an accumulator.
+ * \param[in]   trend: Pointer to the accumulator.
+ * \param[out]  average_direction_degrees: Pointer to integer that will contain the average wind direction in degrees.
+ * \param[out]  direction_status: Pointer to the wind direction status.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_BULK_trend_get_direction(SEN15901_BULK_trend_t* trend, int32_t* average_direction_degrees, SEN15901_wind_direction_status_t* direction_status);
+
+#endif /* SEN15901_DRIVER_DISABLE */
+
+#endif /* __SEN15901_BULK_H__ */
@@ -22,70 +22,164 @@
  * \fn SEN15901_HW_gpio_edge_irq_cb_t
  * \brief GPIO edge interrupt callback.
  *******************************************************************/
-typedef void (*SEN15901_HW_gpio_edge_irq_cb_t)(void);
+typedef void (*SEN15901_HW_gpio_edge_irq_cb_t)(SEN15901_context_t* context);
 
 /*!******************************************************************
  * \fn SEN15901_HW_tick_second_irq_cb_t
- * \brief 1 second timer interrupt callback.
+ * \brief 1 second timer interrupt callback (wake-up timer expiration in tickless mode).
  *******************************************************************/
-typedef void (*SEN15901_HW_tick_second_irq_cb_t)(void);
+typedef void (*SEN15901_HW_tick_second_irq_cb_t)(SEN15901_context_t* context);
+
+#ifdef SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT
+/*!******************************************************************
+ * \fn SEN15901_HW_capture_irq_cb_t
+ * \brief Timer input capture interrupt callback.
+ *******************************************************************/
+typedef void (*SEN15901_HW_capture_irq_cb_t)(SEN15901_context_t* context, uint32_t capture_us);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+/*!******************************************************************
+ * \fn SEN15901_HW_adc_done_irq_cb_t
+ * \brief Wind direction ADC conversion completion callback.
+ *******************************************************************/
+typedef void (*SEN15901_HW_adc_done_irq_cb_t)(SEN15901_context_t* context);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+/*!******************************************************************
+ * \fn SEN15901_HW_tick_gust_irq_cb_t
+ * \brief Wind gust sampling timer interrupt callback (SEN15901_DRIVER_WIND_GUST_SAMPLES_PER_SECOND times per second).
+ *******************************************************************/
+typedef void (*SEN15901_HW_tick_gust_irq_cb_t)(SEN15901_context_t* context);
+#endif
 
 /*!******************************************************************
  * \struct SEN15901_HW_configuration_t
  * \brief SEN15901 hardware interface parameters.
  *******************************************************************/
 typedef struct {
+    uint8_t hw_instance;
     SEN15901_HW_gpio_edge_irq_cb_t wind_speed_edge_irq_callback;
     SEN15901_HW_gpio_edge_irq_cb_t rainfall_edge_irq_callback;
+#ifdef SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT
+    SEN15901_HW_capture_irq_cb_t wind_speed_capture_irq_callback;
+#endif
     SEN15901_HW_tick_second_irq_cb_t tick_second_irq_callback;
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    SEN15901_HW_tick_gust_irq_cb_t tick_gust_irq_callback;
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+    SEN15901_HW_adc_done_irq_cb_t adc_done_irq_callback;
+#endif
 } SEN15901_HW_configuration_t;
 
 /*** SEN15901 HW functions ***/
 
 /*!******************************************************************
- * \fn SEN15901_status_t SEN15901_HW_init(SEN15901_HW_configuration_t* configuration)
+ * \fn SEN15901_status_t SEN15901_HW_init(SEN15901_context_t* context, SEN15901_HW_configuration_t* configuration)
  * \brief Init SEN15901 hardware interface.
+ * \param[in]   context: Pointer to the driver instance context, to be given back as argument of the interrupt callbacks.
  * \param[in]   configuration: Pointer to the hardware interface parameters structure.
  * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
-SEN15901_status_t SEN15901_HW_init(SEN15901_HW_configuration_t* configuration);
+SEN15901_status_t SEN15901_HW_init(SEN15901_context_t* context, SEN15901_HW_configuration_t* configuration);
 
 /*!******************************************************************
- * \fn SEN15901_status_t SEN15901_HW_de_init(void)
+ * \fn SEN15901_status_t SEN15901_HW_de_init(SEN15901_context_t* context)
  * \brief Release SEN15901 hardware interface.
- * \param[in]   none
+ * \param[in]   context: Pointer to the driver instance context.
  * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
-SEN15901_status_t SEN15901_HW_de_init(void);
+SEN15901_status_t SEN15901_HW_de_init(SEN15901_context_t* context);
 
 /*!******************************************************************
- * \fn SEN15901_status_t SEN15901_HW_set_wind_speed_interrupt(uint8_t enable)
- * \brief Set wind speed interrupt state.
+ * \fn SEN15901_status_t SEN15901_HW_set_wind_speed_interrupt(SEN15901_context_t* context, uint8_t enable)
+ * \brief Set wind speed interrupt state (also called from interrupt context by the storm guard when SEN15901_DRIVER_EDGE_DEBOUNCE is defined).
+ * \param[in]   context: Pointer to the driver instance context.
  * \param[in]   enable: Disable (0) or enable (otherwise) the wind speed GPIO interrupt.
  * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
-SEN15901_status_t SEN15901_HW_set_wind_speed_interrupt(uint8_t enable);
+SEN15901_status_t SEN15901_HW_set_wind_speed_interrupt(SEN15901_context_t* context, uint8_t enable);
 
 /*!******************************************************************
- * \fn SEN15901_status_t SEN15901_HW_set_rainfall_interrupt(uint8_t enable)
- * \brief Set rainfall interrupt state.
+ * \fn SEN15901_status_t SEN15901_HW_set_rainfall_interrupt(SEN15901_context_t* context, uint8_t enable)
+ * \brief Set rainfall interrupt state (also called from interrupt context by the storm guard when SEN15901_DRIVER_EDGE_DEBOUNCE is defined).
+ * \param[in]   context: Pointer to the driver instance context.
  * \param[in]   enable: Disable (0) or enable (otherwise) the rainfall GPIO interrupt.
  * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
-SEN15901_status_t SEN15901_HW_set_rainfall_interrupt(uint8_t enable);
+SEN15901_status_t SEN15901_HW_set_rainfall_interrupt(SEN15901_context_t* context, uint8_t enable);
 
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
 /*!******************************************************************
- * \fn SEN15901_status_t SEN15901_HW_adc_get_wind_direction_ratio(int32_t* wind_direction_ratio_permille)
+ * \fn SEN15901_status_t SEN15901_HW_adc_start_wind_direction_conversion(SEN15901_context_t* context, int32_t* wind_direction_ratios_permille, uint8_t ratios_count)
+ * \brief Start a burst of wind direction analog input conversions without waiting for the result.
+ * \brief The adc_done_irq_callback function has to be called once all the ratios have been written.
+ * \param[in]   context: Pointer to the driver instance context.
+ * \param[in]   ratios_count: Number of conversions of the burst (SEN15901_WIND_DIRECTION_SAMPLES_NUMBER).
+ * \param[out]  wind_direction_ratios_permille: Buffer where the ratios in per-mille have to be written.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_HW_adc_start_wind_direction_conversion(SEN15901_context_t* context, int32_t* wind_direction_ratios_permille, uint8_t ratios_count);
+#elif (defined SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING)
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_HW_adc_get_wind_direction_ratios(SEN15901_context_t* context, int32_t* wind_direction_ratios_permille, uint8_t ratios_count)
+ * \brief Read a burst of wind direction analog input ratios within a single power-on window.
+ * \param[in]   context: Pointer to the driver instance context.
+ * \param[in]   ratios_count: Number of conversions of the burst (SEN15901_WIND_DIRECTION_SAMPLES_NUMBER).
+ * \param[out]  wind_direction_ratios_permille: Buffer where the ratios in per-mille have to be written.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_HW_adc_get_wind_direction_ratios(SEN15901_context_t* context, int32_t* wind_direction_ratios_permille, uint8_t ratios_count);
+#else
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_HW_adc_get_wind_direction_ratio(SEN15901_context_t* context, int32_t* wind_direction_ratio_permille)
  * \brief Read wind direction analog input ratio.
- * \param[in]   none
+ * \param[in]   context: Pointer to the driver instance context.
  * \param[out]  wind_direction_ratio_permille: Wind direction analog input ratio in per-mille.
  * \retval      Function execution status.
  *******************************************************************/
-SEN15901_status_t SEN15901_HW_adc_get_wind_direction_ratio(int32_t* wind_direction_ratio_permille);
+SEN15901_status_t SEN15901_HW_adc_get_wind_direction_ratio(SEN15901_context_t* context, int32_t* wind_direction_ratio_permille);
+#endif
+
+#ifdef SEN15901_DRIVER_TICKLESS
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_HW_set_wakeup_timer(SEN15901_context_t* context, uint32_t delay_seconds)
+ * \brief Program the one-shot wake-up timer which replaces the 1 second tick (called from interrupt context).
+ * \param[in]   context: Pointer to the driver instance context.
+ * \param[in]   delay_seconds: Delay after which the tick_second_irq_callback has to be called once, 0 to stop the timer.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_HW_set_wakeup_timer(SEN15901_context_t* context, uint32_t delay_seconds);
+#endif
+
+#if ((defined SEN15901_DRIVER_EDGE_RING_SIZE) || (defined SEN15901_DRIVER_EDGE_DEBOUNCE))
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_HW_get_timestamp_us(SEN15901_context_t* context, uint32_t* timestamp_us)
+ * \brief Read a free running microseconds timestamp (called from the edge interrupt callbacks).
+ * \param[in]   context: Pointer to the driver instance context.
+ * \param[out]  timestamp_us: Pointer to integer that will contain the current timestamp in microseconds.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_HW_get_timestamp_us(SEN15901_context_t* context, uint32_t* timestamp_us);
+#endif
+
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_HW_get_cycle_count(SEN15901_context_t* context, uint32_t* cycle_count)
+ * \brief Read a free running cycle counter (such as the Cortex-M DWT cycle counter) to measure the process function duration.
+ * \param[in]   context: Pointer to the driver instance context.
+ * \param[out]  cycle_count: Pointer to integer that will contain the current counter value.
+ * \retval      Function execution status (durations are not recorded when the function is not implemented).
+ *******************************************************************/
+SEN15901_status_t SEN15901_HW_get_cycle_count(SEN15901_context_t* context, uint32_t* cycle_count);
+#endif
 
 #endif /* SEN15901_DRIVER_DISABLE */
 
@@ -0,0 +1,102 @@
+/*
+ * sen15901_hw_sim.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SEN15901_HW_SIM_H__
+#define __SEN15901_HW_SIM_H__
+
+#ifndef SEN15901_DRIVER_DISABLE_FLAGS_FILE
+#include "sen15901_driver_flags.h"
+#endif
+#include "sen15901.h"
+#include "types.h"
+
+#if (!(defined SEN15901_DRIVER_DISABLE) && (defined SEN15901_DRIVER_HW_SIMULATION))
+
+/*** SEN15901 HW SIM macros ***/
+
+#define SEN15901_HW_SIM_INSTANCES_NUMBER    4
+
+/*** SEN15901 HW SIM structures ***/
+
+/*!******************************************************************
+ * \struct SEN15901_HW_SIM_trace_second_t
+ * \brief Sensor activity recorded (or generated) over 1 second.
+ *******************************************************************/
+typedef struct {
+    uint16_t wind_speed_edge_count;
+    uint16_t rain_edge_count;
+    int16_t wind_direction_ratio_permille;
+} SEN15901_HW_SIM_trace_second_t;
+
+/*!******************************************************************
+ * \struct SEN15901_HW_SIM_statistics_t
+ * \brief Replay counters and host execution times.
+ *******************************************************************/
+typedef struct {
+    uint32_t tick_count;
+    uint64_t tick_time_ns;
+    uint32_t edge_count;
+    uint64_t edge_time_ns;
+    uint32_t wind_direction_sample_count;
+    uint64_t wind_direction_time_ns;
+    uint32_t rain_edge_count;
+} SEN15901_HW_SIM_statistics_t;
+
+/*** SEN15901 HW SIM functions ***/
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_HW_SIM_set_wind_direction_ratio(SEN15901_context_t* context, int32_t wind_direction_ratio_permille)
+ * \brief Set the simulated wind direction analog input ratio.
+ * \param[in]   context: Pointer to the driver instance context.
+ * \param[in]   wind_direction_ratio_permille: Ratio returned by the next ADC conversions in per-mille.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_HW_SIM_set_wind_direction_ratio(SEN15901_context_t* context, int32_t wind_direction_ratio_permille);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_HW_SIM_replay(SEN15901_context_t* context, const SEN15901_HW_SIM_trace_second_t* trace, uint32_t trace_size, SEN15901_HW_SIM_statistics_t* statistics)
+ * \brief Replay a trace through the interrupt callbacks and the process function of an instance, as fast as possible.
+ * \param[in]   context: Pointer to the driver instance context.
+ * \param[in]   trace: Trace to replay, one element per second.
+ * \param[in]   trace_size: Number of seconds of the trace.
+ * \param[out]  statistics: Pointer to the structure where the replay counters and execution times will be added.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_HW_SIM_replay(SEN15901_context_t* context, const SEN15901_HW_SIM_trace_second_t* trace, uint32_t trace_size, SEN15901_HW_SIM_statistics_t* statistics);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_HW_SIM_wind_speed_edge(SEN15901_context_t* context, SEN15901_HW_SIM_statistics_t* statistics)
+ * \brief Generate a single anemometer edge at the current simulated time.
+ * \brief With SEN15901_DRIVER_SMP, the edge functions and the tick function may be called from different threads, each one with its own statistics structure.
+ * \param[in]   context: Pointer to the driver instance context.
+ * \param[out]  statistics: Pointer to the structure where the edge counter and execution time will be added.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_HW_SIM_wind_speed_edge(SEN15901_context_t* context, SEN15901_HW_SIM_statistics_t* statistics);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_HW_SIM_rainfall_edge(SEN15901_context_t* context, SEN15901_HW_SIM_statistics_t* statistics)
+ * \brief Generate a single rain gauge edge at the current simulated time.
+ * \param[in]   context: Pointer to the driver instance context.
+ * \param[out]  statistics: Pointer to the structure where the edge counter will be added.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_HW_SIM_rainfall_edge(SEN15901_context_t* context, SEN15901_HW_SIM_statistics_t* statistics);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_HW_SIM_tick_second(SEN15901_context_t* context, SEN15901_HW_SIM_statistics_t* statistics)
+ * \brief Generate a single second tick and call the process function of the instance.
+ * \param[in]   context: Pointer to the driver instance context.
+ * \param[out]  statistics: Pointer to the structure where the tick counters and execution times will be added.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_HW_SIM_tick_second(SEN15901_context_t* context, SEN15901_HW_SIM_statistics_t* statistics);
+
+#endif /* SEN15901_DRIVER_DISABLE */
+
+#endif /* __SEN15901_HW_SIM_H__ */
@@ -0,0 +1,171 @@
+/*
+ * sen15901_log.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SEN15901_LOG_H__
+#define __SEN15901_LOG_H__
+
+#ifndef SEN15901_DRIVER_DISABLE_FLAGS_FILE
+#include "sen15901_driver_flags.h"
+#endif
+#include "sen15901.h"
+#include "types.h"
+
+#if (!(defined SEN15901_DRIVER_DISABLE) && (defined SEN15901_DRIVER_LOG_BLOCK_SIZE))
+
+/*** SEN15901 LOG macros ***/
+
+#define SEN15901_LOG_DIRECTION_SECTOR_UNDEFINED     SEN15901_WIND_ROSE_SECTORS_NUMBER
+#define SEN15901_LOG_WIND_SPEED_RESOLUTION_MH       100
+
+/*** SEN15901 LOG structures ***/
+
+/*!******************************************************************
+ * \struct SEN15901_LOG_record_t
+ * \brief Measurements of one reporting period.
+ *******************************************************************/
+typedef struct {
+    uint32_t index;
+    int32_t average_speed_mh;
+    int32_t gust_speed_mh;
+    uint8_t direction_sector;
+    uint32_t rain_edge_count;
+} SEN15901_LOG_record_t;
+
+/*!******************************************************************
+ * \struct SEN15901_LOG_context_t
+ * \brief Ring of encoded records blocks in a caller buffer (context allocated by the caller).
+ *******************************************************************/
+typedef struct {
+    uint8_t* buffer;
+    uint32_t blocks_number;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t write_offset;
+    uint8_t write_records_count;
+    uint8_t read_pending_flag;
+    uint32_t record_index;
+    uint32_t lost_count;
+    SEN15901_LOG_record_t record_last;
+} SEN15901_LOG_context_t;
+
+/*!******************************************************************
+ * \struct SEN15901_LOG_iterator_t
+ * \brief Records decoder of a block read from the log.
+ *******************************************************************/
+typedef struct {
+    const uint8_t* data;
+    uint32_t size;
+    uint32_t offset;
+    SEN15901_LOG_record_t record_last;
+} SEN15901_LOG_iterator_t;
+
+/*** SEN15901 LOG functions ***/
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_LOG_init(SEN15901_LOG_context_t* log, uint8_t* buffer, uint32_t buffer_size)
+ * \brief Init an empty records log (all blocks of the storage are erased).
+ * \param[in]   log: Pointer to the log context.
+ * \param[in]   buffer: Memory used to store the encoded records, split in blocks of SEN15901_DRIVER_LOG_BLOCK_SIZE bytes.
+ * \param[in]   buffer_size: Size of the buffer in bytes (at least 2 blocks).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_LOG_init(SEN15901_LOG_context_t* log, uint8_t* buffer, uint32_t buffer_size);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_LOG_recover(SEN15901_LOG_context_t* log, uint8_t* buffer, uint32_t buffer_size)
+ * \brief Init a records log from the blocks kept in the storage after a reset.
+ * \brief The last block is reopened after its last complete record, a record truncated by the reset is dropped.
+ * \param[in]   log: Pointer to the log context.
+ * \param[in]   buffer: Memory where the encoded records are stored, split in blocks of SEN15901_DRIVER_LOG_BLOCK_SIZE bytes.
+ * \param[in]   buffer_size: Size of the buffer in bytes (at least 2 blocks).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_LOG_recover(SEN15901_LOG_context_t* log, uint8_t* buffer, uint32_t buffer_size);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_LOG_append(SEN15901_LOG_context_t* log, const SEN15901_LOG_record_t* record)
+ * \brief Add a record to the log, the oldest block is dropped when the log is full.
+ * \param[in]   log: Pointer to the log context.
+ * \param[in]   record: Pointer to the record to add (the index field is set by the log).
+ * \param[out]  none
+ * \retval      Function execution status (SEN15901_ERROR_LOG_FULL when the oldest block is being read and the record is lost).
+ *******************************************************************/
+SEN15901_status_t SEN15901_LOG_append(SEN15901_LOG_context_t* log, const SEN15901_LOG_record_t* record);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_LOG_append_snapshot(SEN15901_LOG_context_t* log, const SEN15901_snapshot_t* snapshot)
+ * \brief Add the measurements of a snapshot to the log.
+ * \param[in]   log: Pointer to the log context.
+ * \param[in]   snapshot: Pointer to the snapshot to add (the peak speed is used as gust when the gust measurement is disabled).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_LOG_append_snapshot(SEN15901_LOG_context_t* log, const SEN15901_snapshot_t* snapshot);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_LOG_flush(SEN15901_LOG_context_t* log)
+ * \brief Close the block being written so that it can be read.
+ * \param[in]   log: Pointer to the log context.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_LOG_flush(SEN15901_LOG_context_t* log);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_LOG_read(SEN15901_LOG_context_t* log, const uint8_t** chunk, uint32_t* chunk_size)
+ * \brief Get the oldest closed block of the log, without copy.
+ * \param[in]   log: Pointer to the log context.
+ * \param[out]  chunk: Pointer that will point to the encoded records of the block in the log buffer.
+ * \param[out]  chunk_size: Pointer to integer that will contain the size of the chunk in bytes (0 if there is no closed block).
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_LOG_read(SEN15901_LOG_context_t* log, const uint8_t** chunk, uint32_t* chunk_size);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_LOG_release(SEN15901_LOG_context_t* log)
+ * \brief Free the block returned by the last read (once uploaded).
+ * \param[in]   log: Pointer to the log context.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_LOG_release(SEN15901_LOG_context_t* log);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_LOG_get_lost_count(SEN15901_LOG_context_t* log, uint32_t* lost_count)
+ * \brief Read the number of records dropped since the log initialization.
+ * \param[in]   log: Pointer to the log context.
+ * \param[out]  lost_count: Pointer to integer that will contain the number of dropped records.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_LOG_get_lost_count(SEN15901_LOG_context_t* log, uint32_t* lost_count);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_LOG_iterator_init(SEN15901_LOG_iterator_t* iterator, const uint8_t* chunk, uint32_t chunk_size)
+ * \brief Start decoding a chunk returned by SEN15901_LOG_read() (on the device or on the server).
+ * \param[in]   iterator: Pointer to the iterator.
+ * \param[in]   chunk: Encoded records.
+ * \param[in]   chunk_size: Size of the chunk in bytes.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_LOG_iterator_init(SEN15901_LOG_iterator_t* iterator, const uint8_t* chunk, uint32_t chunk_size);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_LOG_iterator_next(SEN15901_LOG_iterator_t* iterator, SEN15901_LOG_record_t* record, uint8_t* record_available)
+ * \brief Decode the next record of a chunk.
+ * \param[in]   iterator: Pointer to the iterator.
+ * \param[out]  record: Pointer to the decoded record.
+ * \param[out]  record_available: Pointer to the flag that will be set to 0 once all records have been decoded.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_LOG_iterator_next(SEN15901_LOG_iterator_t* iterator, SEN15901_LOG_record_t* record, uint8_t* record_available);
+
+#endif /* SEN15901_DRIVER_DISABLE */
+
+#endif /* __SEN15901_LOG_H__ */
@@ -0,0 +1,52 @@
+/*
+ * sen15901_log_hw.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SEN15901_LOG_HW_H__
+#define __SEN15901_LOG_HW_H__
+
+#ifndef SEN15901_DRIVER_DISABLE_FLAGS_FILE
+#include "sen15901_driver_flags.h"
+#endif
+#include "sen15901.h"
+#include "sen15901_log.h"
+#include "types.h"
+
+#if (!(defined SEN15901_DRIVER_DISABLE) && (defined SEN15901_DRIVER_LOG_BLOCK_SIZE))
+
+/*** SEN15901 LOG HW macros ***/
+
+#define SEN15901_LOG_HW_ERASED_BYTE     0xFF
+
+/*** SEN15901 LOG HW functions ***/
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_LOG_HW_erase_block(SEN15901_LOG_context_t* log, uint32_t block_index)
+ * \brief Erase a block of the log storage (all bytes set to SEN15901_LOG_HW_ERASED_BYTE).
+ * \brief The default weak implementation works on the RAM buffer given to SEN15901_LOG_init().
+ * \param[in]   log: Pointer to the log context.
+ * \param[in]   block_index: Index of the block in the storage.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_LOG_HW_erase_block(SEN15901_LOG_context_t* log, uint32_t block_index);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_LOG_HW_write(SEN15901_LOG_context_t* log, uint32_t offset, const uint8_t* data, uint32_t data_size)
+ * \brief Write bytes in the log storage, the storage is then read directly through the buffer pointer (memory mapped).
+ * \brief The default weak implementation works on the RAM buffer given to SEN15901_LOG_init().
+ * \param[in]   log: Pointer to the log context.
+ * \param[in]   offset: Offset of the first byte in the storage.
+ * \param[in]   data: Bytes to write.
+ * \param[in]   data_size: Number of bytes to write.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_LOG_HW_write(SEN15901_LOG_context_t* log, uint32_t offset, const uint8_t* data, uint32_t data_size);
+
+#endif /* SEN15901_DRIVER_DISABLE */
+
+#endif /* __SEN15901_LOG_HW_H__ */
@@ -0,0 +1,49 @@
+/*
+ * sen15901_payload.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SEN15901_PAYLOAD_H__
+#define __SEN15901_PAYLOAD_H__
+
+#ifndef SEN15901_DRIVER_DISABLE_FLAGS_FILE
+#include "sen15901_driver_flags.h"
+#endif
+#include "sen15901.h"
+#include "types.h"
+
+#if (!(defined SEN15901_DRIVER_DISABLE) && (defined SEN15901_DRIVER_PAYLOAD))
+
+/*** SEN15901 PAYLOAD macros ***/
+
+// Average speed, gust (or peak) speed, direction valid bit, direction sector and rainfall.
+#define SEN15901_PAYLOAD_SIZE_BITS      ((2 * SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS) + 1 + SEN15901_DRIVER_PAYLOAD_WIND_DIRECTION_BITS + SEN15901_DRIVER_PAYLOAD_RAINFALL_BITS)
+#define SEN15901_PAYLOAD_SIZE_BYTES     ((SEN15901_PAYLOAD_SIZE_BITS + 7) / 8)
+
+/*** SEN15901 PAYLOAD functions ***/
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_PAYLOAD_encode(const SEN15901_snapshot_t* snapshot, uint8_t* payload, uint8_t payload_size)
+ * \brief Pack a snapshot into an uplink payload (fields are rounded to their resolution and saturated to their width).
+ * \param[in]   snapshot: Pointer to the snapshot to encode.
+ * \param[in]   payload_size: Size of the payload buffer in bytes (at least SEN15901_PAYLOAD_SIZE_BYTES).
+ * \param[out]  payload: Buffer where the SEN15901_PAYLOAD_SIZE_BYTES bytes of the payload will be written.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_PAYLOAD_encode(const SEN15901_snapshot_t* snapshot, uint8_t* payload, uint8_t payload_size);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_PAYLOAD_decode(const uint8_t* payload, uint8_t payload_size, SEN15901_snapshot_t* snapshot)
+ * \brief Unpack an uplink payload (server side), with the same flags as the device.
+ * \param[in]   payload: Payload to decode.
+ * \param[in]   payload_size: Size of the payload in bytes.
+ * \param[out]  snapshot: Pointer to the snapshot where the average speed, gust (or peak) speed, direction and rainfall will be written.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_PAYLOAD_decode(const uint8_t* payload, uint8_t payload_size, SEN15901_snapshot_t* snapshot);
+
+#endif /* SEN15901_DRIVER_DISABLE */
+
+#endif /* __SEN15901_PAYLOAD_H__ */
@@ -13,291 +13,2794 @@
 #include "error.h"
 #include "maths.h"
 #include "sen15901_hw.h"
+#include "sen15901_tables.h"
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_LUT
+#include "sen15901_wind_direction_lut.h"
+#endif
 #include "types.h"
 
-#ifndef SEN15901_DRIVER_DISABLE
+#ifndef SEN15901_DRIVER_DISABLE
+
+/*** SEN15901 local macros ***/
+
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+#if ((SEN15901_DRIVER_EDGE_RING_SIZE & (SEN15901_DRIVER_EDGE_RING_SIZE - 1)) != 0)
+#error "SEN15901 driver: SEN15901_DRIVER_EDGE_RING_SIZE must be a power of two"
+#endif
+#define SEN15901_EDGE_RING_MASK                                 (SEN15901_DRIVER_EDGE_RING_SIZE - 1)
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT
+#ifndef SEN15901_DRIVER_EDGE_RING_SIZE
+#error "SEN15901 driver: SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT requires SEN15901_DRIVER_EDGE_RING_SIZE"
+#endif
+#define SEN15901_WIND_SPEED_PERIOD_TIMEOUT_US                   10000000
+#define SEN15901_WIND_SPEED_PERIOD_EDGE_COUNT_MAX(seconds)      (SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT * (seconds))
+#endif
+
+#if ((SEN15901_WIND_DIRECTION_SAMPLES_NUMBER == 0) || (SEN15901_WIND_DIRECTION_SAMPLES_NUMBER > 255))
+#error "SEN15901 driver: SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING must be between 1 and 255"
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS
+#ifndef SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BIN_WIDTH_MH
+#error "SEN15901 driver: SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BIN_WIDTH_MH must be defined with SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS"
+#endif
+#if ((SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS == 0) || (SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS > 255) || (SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BIN_WIDTH_MH == 0))
+#error "SEN15901 driver: wind speed histogram must have between 1 and 255 bins of non-zero width"
+#endif
+#endif
+
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+#define SEN15901_RAIN_RATE_RING_MASK                (SEN15901_DRIVER_RAIN_RATE_RING_SIZE - 1)
+#if ((SEN15901_DRIVER_RAIN_RATE_RING_SIZE & SEN15901_RAIN_RATE_RING_MASK) != 0)
+#error "SEN15901 driver: SEN15901_DRIVER_RAIN_RATE_RING_SIZE must be a power of two"
+#endif
+#endif
+
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+#if (!(defined SEN15901_DRIVER_WIND_SPEED_DEBOUNCE_US) || !(defined SEN15901_DRIVER_RAINFALL_DEBOUNCE_US))
+#error "SEN15901 driver: SEN15901_DRIVER_WIND_SPEED_DEBOUNCE_US and SEN15901_DRIVER_RAINFALL_DEBOUNCE_US are required by SEN15901_DRIVER_EDGE_DEBOUNCE"
+#endif
+// Raw edges rate above which an input is considered as stormed, relatively to the maximum debounced rate.
+#define SEN15901_EDGE_STORM_FACTOR                              4
+#endif
+
+#ifdef SEN15901_DRIVER_TICKLESS
+// Deadline value meaning that the wake-up timer can be stopped.
+#define SEN15901_WAKEUP_DELAY_NONE                              0xFFFFFFFF
+// Longest one-shot timer delay.
+#define SEN15901_WAKEUP_DELAY_SECONDS_MAX                       0xFF
+#endif
+
+#ifdef SEN15901_DRIVER_ADAPTIVE_SAMPLING
+// Number of consecutive stable samples before the periods are doubled.
+#define SEN15901_ADAPTIVE_SAMPLING_STABLE_SAMPLES               4
+// Speed change above which a sample is unstable (absolute floor and fraction of the previous speed as a shift).
+#define SEN15901_ADAPTIVE_SAMPLING_WIND_SPEED_DELTA_MIN_MH      2000
+#define SEN15901_ADAPTIVE_SAMPLING_WIND_SPEED_DELTA_SHIFT       2
+// Direction change above which a sample is unstable (more than one sector).
+#define SEN15901_ADAPTIVE_SAMPLING_WIND_DIRECTION_DELTA_DEGREES 30
+#define SEN15901_WIND_SPEED_SAMPLING_TIME_SECONDS(context)      ((context)->adaptive_sampling.wind_speed_period_seconds)
+#define SEN15901_WIND_DIRECTION_SAMPLING_PERIOD_SECONDS(context) ((context)->adaptive_sampling.wind_direction_period_seconds)
+#else
+#define SEN15901_WIND_SPEED_SAMPLING_TIME_SECONDS(context)      SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS
+#define SEN15901_WIND_DIRECTION_SAMPLING_PERIOD_SECONDS(context) SEN15901_DRIVER_WIND_DIRECTION_SAMPLING_PERIOD_SECONDS
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+// Fractional scale of the mean unit vector used by the standard deviation.
+#define SEN15901_WIND_DIRECTION_SIGMA_MEAN_SCALE                ((int64_t) 1 << 15)
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION
+#if (SEN15901_WIND_ROSE_SECTORS_NUMBER != SEN15901_WIND_DIRECTIONS_NUMBER)
+#error "SEN15901 driver: wind direction calibration sectors number mismatch"
+#endif
+// Minimum number of ratios of a sector to update its plateau at the end of the learning.
+#define SEN15901_WIND_DIRECTION_LEARNING_SAMPLES_MIN            8
+#define SEN15901_WIND_DIRECTION_LEARNING_SAMPLES_MAX            65535
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+#ifndef SEN15901_DRIVER_WIND_GUST_SAMPLES_PER_SECOND
+#error "SEN15901 driver: SEN15901_DRIVER_WIND_GUST_SAMPLES_PER_SECOND must be defined with SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS"
+#endif
+#if ((SEN15901_WIND_GUST_SAMPLES_NUMBER == 0) || (SEN15901_WIND_GUST_SAMPLES_NUMBER > 255))
+#error "SEN15901 driver: wind gust samples number must be between 1 and 255"
+#endif
+// Requests of the process function to the gust interrupt, which publishes (or drops) the interval maximum and starts a new one.
+#define SEN15901_WIND_GUST_REQUEST_NONE                         0
+#define SEN15901_WIND_GUST_REQUEST_PUBLISH                      1
+#define SEN15901_WIND_GUST_REQUEST_DISCARD                      2
+#endif
+
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+#define SEN15901_INSTRUMENTATION_IRQ(context, source)           { (context)->instrumentation_##source##_irq_count++; }
+#define SEN15901_INSTRUMENTATION_EDGE(context, source)          { (context)->instrumentation_##source##_edge_irq_count++; (context)->instrumentation_##source##_edge_second_count++; }
+#define SEN15901_INSTRUMENTATION_TICK(context, seconds)         { _SEN15901_update_instrumentation_edge_rates(context, seconds); }
+#define SEN15901_INSTRUMENTATION_PROCESS_START(context)         { _SEN15901_start_instrumentation_process(context); }
+#define SEN15901_INSTRUMENTATION_PROCESS_END(context)           { _SEN15901_stop_instrumentation_process(context); }
+#else
+#define SEN15901_INSTRUMENTATION_IRQ(context, source)           {}
+#define SEN15901_INSTRUMENTATION_EDGE(context, source)          {}
+#define SEN15901_INSTRUMENTATION_TICK(context, seconds)         {}
+#define SEN15901_INSTRUMENTATION_PROCESS_START(context)         {}
+#define SEN15901_INSTRUMENTATION_PROCESS_END(context)           {}
+#endif
+
+#ifdef SEN15901_DRIVER_SMP
+// Remove the observed value only, so that the increments done by another core since the read are kept.
+#define SEN15901_SHARED_CONSUME(variable, value)                { atomic_fetch_sub(&(variable), value); }
+#define SEN15901_WRITE_BEGIN(context)                           { _SEN15901_write_begin(context); }
+#define SEN15901_WRITE_TOGGLE(context)                          { atomic_fetch_add(&((context)->write_sequence), 1); }
+#define SEN15901_WRITE_END(context)                             { _SEN15901_write_end(context); }
+#define SEN15901_READ_BEGIN(context)                            { uint32_t read_sequence = 0; do { read_sequence = _SEN15901_read_begin(context);
+#define SEN15901_READ_END(context)                              } while (_SEN15901_read_retry(context, read_sequence) != 0); }
+#else
+#define SEN15901_SHARED_CONSUME(variable, value)                { UNUSED(value); (variable) = 0; }
+#define SEN15901_WRITE_BEGIN(context)                           {}
+#define SEN15901_WRITE_TOGGLE(context)                          {}
+#define SEN15901_WRITE_END(context)                             {}
+#define SEN15901_READ_BEGIN(context)                            {
+#define SEN15901_READ_END(context)                              }
+#endif
+
+/*** SEN15901 local global variables ***/
+
+#if ((defined SEN15901_DRIVER_WIND_ROSE) || (defined SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION))
+// Wind rose sector (clockwise from north) of each direction.
+static const uint8_t SEN15901_WIND_DIRECTION_ROSE_SECTOR[SEN15901_WIND_DIRECTIONS_NUMBER] = { 5, 3, 4, 7, 6, 9, 8, 1, 2, 11, 10, 15, 0, 13, 14, 12 };
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION
+// Ratio of each direction with nominal resistors, used for the sectors which are not calibrated.
+static const int32_t SEN15901_WIND_DIRECTION_RATIO_NOMINAL[SEN15901_WIND_DIRECTIONS_NUMBER] = {
+    SEN15901_RESISTOR_DIVIDER_RATIO(688),
+    SEN15901_RESISTOR_DIVIDER_RATIO(891),
+    SEN15901_RESISTOR_DIVIDER_RATIO(1000),
+    SEN15901_RESISTOR_DIVIDER_RATIO(1410),
+    SEN15901_RESISTOR_DIVIDER_RATIO(2200),
+    SEN15901_RESISTOR_DIVIDER_RATIO(3140),
+    SEN15901_RESISTOR_DIVIDER_RATIO(3900),
+    SEN15901_RESISTOR_DIVIDER_RATIO(6570),
+    SEN15901_RESISTOR_DIVIDER_RATIO(8200),
+    SEN15901_RESISTOR_DIVIDER_RATIO(14120),
+    SEN15901_RESISTOR_DIVIDER_RATIO(16000),
+    SEN15901_RESISTOR_DIVIDER_RATIO(21880),
+    SEN15901_RESISTOR_DIVIDER_RATIO(33000),
+    SEN15901_RESISTOR_DIVIDER_RATIO(42120),
+    SEN15901_RESISTOR_DIVIDER_RATIO(64900),
+    SEN15901_RESISTOR_DIVIDER_RATIO(120000)
+};
+#endif
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+static const uint32_t SEN15901_RAIN_RATE_WINDOW_SECONDS[SEN15901_RAIN_RATE_WINDOW_LAST] = { 60, 600, 3600 };
+#endif
+#ifdef SEN15901_DRIVER_AGGREGATION
+static const uint32_t SEN15901_AGGREGATION_LEVEL_1_MINUTE_SECONDS = 60;
+// Number of completed intervals of each level folded into its parent level.
+static const uint8_t SEN15901_AGGREGATION_CHILDREN_NUMBER[SEN15901_AGGREGATION_LEVEL_LAST - 1] = { 10, 6 };
+#endif
+
+#ifndef SEN15901_DRIVER_SINGLETON_API_DISABLE
+static SEN15901_context_t sen15901_ctx;
+static SEN15901_singleton_process_cb_t sen15901_process_callback = NULL;
+#endif
+
+/*** SEN15901 local functions ***/
+
+#ifndef SEN15901_DRIVER_SINGLETON_API_DISABLE
+/*******************************************************************/
+static void _SEN15901_process_callback(SEN15901_context_t* context) {
+    // Default instance callback does not take the context.
+    UNUSED(context);
+    if (sen15901_process_callback != NULL) {
+        sen15901_process_callback();
+    }
+}
+#endif
+
+#ifdef SEN15901_DRIVER_SMP
+/*******************************************************************/
+static void _SEN15901_write_begin(SEN15901_context_t* context) {
+    // Serialize writers (process, snapshot and reset functions).
+    while (atomic_flag_test_and_set_explicit(&(context->write_lock), memory_order_acquire)) {
+    }
+    // Odd sequence: readers will retry.
+    atomic_fetch_add(&(context->write_sequence), 1);
+}
+
+/*******************************************************************/
+static void _SEN15901_write_end(SEN15901_context_t* context) {
+    // Called on the error path of the process function, before the lock is taken when the context is NULL.
+    if (context == NULL) return;
+    if ((atomic_load(&(context->write_sequence)) & 0x01) != 0) {
+        atomic_fetch_add(&(context->write_sequence), 1);
+    }
+    atomic_flag_clear_explicit(&(context->write_lock), memory_order_release);
+}
+
+/*******************************************************************/
+static uint32_t _SEN15901_read_begin(SEN15901_context_t* context) {
+    // Local variables.
+    uint32_t sequence = 0;
+    // Wait for the end of the current update, the writer is never blocked.
+    do {
+        sequence = atomic_load_explicit(&(context->write_sequence), memory_order_acquire);
+    }
+    while ((sequence & 0x01) != 0);
+    return sequence;
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_read_retry(SEN15901_context_t* context, uint32_t sequence) {
+    // Read again if a writer has modified the measurements in the meantime.
+    atomic_thread_fence(memory_order_acquire);
+    return ((atomic_load_explicit(&(context->write_sequence), memory_order_relaxed) != sequence) ? 1 : 0);
+}
+#endif
+
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+/*******************************************************************/
+static void _SEN15901_edge_ring_reset(SEN15901_edge_ring_t* ring) {
+    // Reset indexes.
+    ring->head = 0;
+    ring->tail = 0;
+    ring->overflow_count = 0;
+    ring->overflow_count_read = 0;
+}
+
+/*******************************************************************/
+static void _SEN15901_edge_ring_push(SEN15901_edge_ring_t* ring, uint32_t timestamp_us) {
+    // Local variables.
+    uint32_t head = (ring->head);
+    // Check free space.
+    if ((head - (ring->tail)) >= SEN15901_DRIVER_EDGE_RING_SIZE) {
+        // Edge will still be counted by the consumer through the overflow counter.
+        ring->overflow_count++;
+    }
+    else {
+        ring->timestamp_us[head & SEN15901_EDGE_RING_MASK] = timestamp_us;
+        // Publish entry once written.
+        ring->head = (head + 1);
+    }
+}
+
+/*******************************************************************/
+static uint32_t _SEN15901_edge_ring_drain(SEN15901_edge_ring_t* ring, uint32_t* overflow_count_new, uint32_t* last_timestamp_us) {
+    // Local variables.
+    uint32_t head = (ring->head);
+    uint32_t overflow_count = (ring->overflow_count);
+    uint32_t edge_count = 0;
+    // Count timestamped and overflowed edges.
+    edge_count = (head - (ring->tail)) + (overflow_count - (ring->overflow_count_read));
+    if (overflow_count_new != NULL) {
+        (*overflow_count_new) = (overflow_count - (ring->overflow_count_read));
+    }
+    if ((last_timestamp_us != NULL) && (head != (ring->tail))) {
+        (*last_timestamp_us) = ring->timestamp_us[(head - 1) & SEN15901_EDGE_RING_MASK];
+    }
+    // Release all entries at once.
+    ring->tail = head;
+    ring->overflow_count_read = overflow_count;
+    return edge_count;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_build_wind_direction_lut(SEN15901_context_t* context, SEN15901_wind_direction_calibration_t* calibration) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    int32_t plateau_permille[SEN15901_WIND_DIRECTIONS_NUMBER];
+    int32_t threshold_permille = 0;
+    int32_t ratio_permille = 0;
+    uint8_t calibrated_count = 0;
+    uint8_t idx = 0;
+    // Calibrated or nominal plateau of each direction.
+    for (idx = 0; idx < SEN15901_WIND_DIRECTIONS_NUMBER; idx++) {
+        plateau_permille[idx] = (int32_t) (calibration->plateau_permille[SEN15901_WIND_DIRECTION_ROSE_SECTOR[idx]]);
+        if (plateau_permille[idx] == 0) {
+            plateau_permille[idx] = SEN15901_WIND_DIRECTION_RATIO_NOMINAL[idx];
+        }
+        else {
+            calibrated_count++;
+        }
+        // Directions must remain sorted by increasing ratio.
+        if ((plateau_permille[idx] > MATH_PERMILLE_MAX) || ((idx > 0) && (plateau_permille[idx] <= plateau_permille[idx - 1]))) {
+            status = SEN15901_ERROR_WIND_DIRECTION_CALIBRATION;
+            goto errors;
+        }
+    }
+    // At least one sector must be calibrated, the context is only updated once the plateaus are validated.
+    if (calibrated_count == 0) {
+        status = SEN15901_ERROR_WIND_DIRECTION_CALIBRATION;
+        goto errors;
+    }
+    // Fill the table in a single pass, thresholds are the middle of consecutive plateaus.
+    idx = 0;
+    threshold_permille = ((plateau_permille[0] + plateau_permille[1]) >> 1);
+    for (ratio_permille = 0; ratio_permille <= MATH_PERMILLE_MAX; ratio_permille++) {
+        while (ratio_permille > threshold_permille) {
+            idx++;
+            threshold_permille = (idx < (SEN15901_WIND_DIRECTIONS_NUMBER - 1)) ? ((plateau_permille[idx] + plateau_permille[idx + 1]) >> 1) : MATH_PERMILLE_MAX;
+        }
+        context->wind_direction_lut[ratio_permille] = idx;
+    }
+    context->wind_direction_lut_valid_flag = 1;
+    context->wind_direction_calibration_applied = (*calibration);
+    context->wind_direction_calibration = (*calibration);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static void _SEN15901_reset_wind_direction_learning(SEN15901_context_t* context) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Reset statistics.
+    for (idx = 0; idx < SEN15901_WIND_ROSE_SECTORS_NUMBER; idx++) {
+        context->wind_direction_learning_sum[idx] = 0;
+        context->wind_direction_learning_count[idx] = 0;
+    }
+}
+
+/*******************************************************************/
+static void _SEN15901_learn_wind_direction(SEN15901_context_t* context, uint8_t wind_direction_index, int32_t wind_direction_ratio_permille) {
+    // Local variables.
+    uint8_t sector = SEN15901_WIND_DIRECTION_ROSE_SECTOR[wind_direction_index];
+    // Accumulate the ratios of each decoded sector.
+    if ((context->wind_direction_learning_flag == 0) || (wind_direction_ratio_permille < 0)) return;
+    if ((context->wind_direction_learning_count[sector]) >= SEN15901_WIND_DIRECTION_LEARNING_SAMPLES_MAX) return;
+    context->wind_direction_learning_sum[sector] += (uint32_t) wind_direction_ratio_permille;
+    context->wind_direction_learning_count[sector]++;
+}
+#endif
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_get_wind_direction_index(SEN15901_context_t* context, int32_t wind_direction_ratio_permille, uint8_t* wind_direction_index) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+#ifndef SEN15901_DRIVER_WIND_DIRECTION_LUT
+    uint8_t idx_low = 0;
+    uint8_t idx_high = (SEN15901_WIND_DIRECTIONS_NUMBER - 1);
+    uint8_t idx_middle = 0;
+#endif
+    // Check ratio range.
+    if (wind_direction_ratio_permille > MATH_PERMILLE_MAX) {
+        status = SEN15901_ERROR_RESISTOR_DIVIDER_RATIO;
+        goto errors;
+    }
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION
+    // Direct access to the calibrated table.
+    if (context->wind_direction_lut_valid_flag != 0) {
+        (*wind_direction_index) = (wind_direction_ratio_permille < 0) ? 0 : context->wind_direction_lut[wind_direction_ratio_permille];
+        goto errors;
+    }
+#else
+    UNUSED(context);
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_LUT
+    // Direct table access (index only, the angle and vector components are read from the constant tables).
+    (*wind_direction_index) = (wind_direction_ratio_permille < 0) ? 0 : SEN15901_WIND_DIRECTION_LUT[wind_direction_ratio_permille];
+#else
+    // Search first threshold greater or equal to the ratio.
+    while (idx_low < idx_high) {
+        idx_middle = ((idx_low + idx_high) >> 1);
+        if (wind_direction_ratio_permille <= SEN15901_WIND_DIRECTION_RATIO_THRESHOLD[idx_middle]) {
+            idx_high = idx_middle;
+        }
+        else {
+            idx_low = (idx_middle + 1);
+        }
+    }
+    (*wind_direction_index) = idx_low;
+#endif
+errors:
+    return status;
+}
+
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+/*******************************************************************/
+static uint32_t _SEN15901_get_wind_speed_edge_count(SEN15901_context_t* context) {
+    // Free running number of edges since init.
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+    return ((context->wind_speed_edge_ring.head) + (context->wind_speed_edge_ring.overflow_count));
+#else
+    return (context->wind_speed_edge_count);
+#endif
+}
+
+/*******************************************************************/
+static void _SEN15901_wind_gust_restart(SEN15901_context_t* context) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Empty sliding window.
+    for (idx = 0; idx < SEN15901_WIND_GUST_SAMPLES_NUMBER; idx++) {
+        context->wind_gust_edge_count[idx] = 0;
+    }
+    context->wind_gust_sample_index = 0;
+    context->wind_gust_samples_count = 0;
+    context->wind_gust_edge_sum = 0;
+    context->wind_gust_edge_count_read = _SEN15901_get_wind_speed_edge_count(context);
+}
+
+/*******************************************************************/
+static void _SEN15901_get_wind_gust(SEN15901_measurements_t* measurements, int32_t* gust_speed_mh) {
+    // Convert maximum edge count of the window to speed.
+    (*gust_speed_mh) = (int32_t) ((measurements->wind_gust_edge_sum_max * SEN15901_WIND_SPEED_1HZ_TO_MH) / (SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS));
+}
+
+/*******************************************************************/
+static void _SEN15901_add_wind_gust(SEN15901_context_t* context, SEN15901_measurements_t* measurements, uint32_t wind_gust_edge_sum_max) {
+    // Update maximum of the bank and of the current minute.
+    if (wind_gust_edge_sum_max > measurements->wind_gust_edge_sum_max) {
+        measurements->wind_gust_edge_sum_max = wind_gust_edge_sum_max;
+    }
+#ifdef SEN15901_DRIVER_AGGREGATION
+    if (wind_gust_edge_sum_max > context->aggregation_current[SEN15901_AGGREGATION_LEVEL_1_MINUTE].wind_gust_edge_sum_max) {
+        context->aggregation_current[SEN15901_AGGREGATION_LEVEL_1_MINUTE].wind_gust_edge_sum_max = wind_gust_edge_sum_max;
+    }
+#else
+    UNUSED(context);
+#endif
+}
+
+/*******************************************************************/
+static void _SEN15901_close_wind_gust(SEN15901_context_t* context, SEN15901_measurements_t* measurements) {
+    // Local variables.
+    uint32_t wind_gust_edge_sum_max = 0;
+    uint32_t wind_gust_edge_sum_max_closed = 0;
+    // Maximum of the samples computed since the previous snapshot (none while the previous restart is pending).
+    if (context->wind_gust_restart_flag == 0) {
+        // The interrupt saves the maximum before restarting the interval, so that it is read here or in the closed value.
+        context->wind_gust_edge_sum_max_closed = 0;
+        context->wind_gust_restart_flag = 1;
+        wind_gust_edge_sum_max = context->wind_gust_edge_sum_max_current;
+        wind_gust_edge_sum_max_closed = context->wind_gust_edge_sum_max_closed;
+        if (wind_gust_edge_sum_max_closed > wind_gust_edge_sum_max) {
+            wind_gust_edge_sum_max = wind_gust_edge_sum_max_closed;
+        }
+        _SEN15901_add_wind_gust(context, measurements, wind_gust_edge_sum_max);
+    }
+    // Maximum handed over before the restart and not read yet by the process function.
+    if (context->wind_gust_request == SEN15901_WIND_GUST_REQUEST_NONE) {
+        _SEN15901_add_wind_gust(context, measurements, context->wind_gust_edge_sum_max_published);
+        context->wind_gust_request = SEN15901_WIND_GUST_REQUEST_PUBLISH;
+    }
+}
+#endif
+
+/*******************************************************************/
+static void _SEN15901_add_wind_direction_vector(SEN15901_measurements_t* measurements, int32_t wind_speed_kmh, uint32_t wind_direction_degrees) {
+    // Local variables.
+    int32_t vector_x = (wind_speed_kmh * ((int32_t) MATH_COS_TABLE[wind_direction_degrees]));
+    int32_t vector_y = (wind_speed_kmh * ((int32_t) MATH_SIN_TABLE[wind_direction_degrees]));
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    // Add new vector.
+    measurements->wind_direction_trend_point_x += (int64_t) vector_x;
+    measurements->wind_direction_trend_point_y += (int64_t) vector_y;
+#else
+    // Add new vector with the current scale.
+    measurements->wind_direction_trend_point_x += (vector_x >> (measurements->wind_direction_trend_point_shift));
+    measurements->wind_direction_trend_point_y += (vector_y >> (measurements->wind_direction_trend_point_shift));
+    // Halve trend point and future vectors before reaching overflow.
+    if ((measurements->wind_direction_trend_point_x > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (measurements->wind_direction_trend_point_x < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT)) ||
+        (measurements->wind_direction_trend_point_y > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (measurements->wind_direction_trend_point_y < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT))) {
+        measurements->wind_direction_trend_point_x >>= 1;
+        measurements->wind_direction_trend_point_y >>= 1;
+        measurements->wind_direction_trend_point_shift++;
+    }
+#endif
+}
+
+#if ((defined SEN15901_DRIVER_WIND_ROSE) || (defined SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS))
+/*******************************************************************/
+static void _SEN15901_increment_histogram_bin(uint16_t* bin) {
+    // Saturate instead of wrapping around.
+    if ((*bin) < 0xFFFF) {
+        (*bin)++;
+    }
+}
+
+#ifdef SEN15901_DRIVER_AGGREGATION
+/*******************************************************************/
+static void _SEN15901_merge_histogram(const uint16_t* source, uint16_t* destination, uint8_t bins_number) {
+    // Local variables.
+    uint32_t bin = 0;
+    uint8_t idx = 0;
+    // Saturating sum of each bin.
+    for (idx = 0; idx < bins_number; idx++) {
+        bin = ((uint32_t) destination[idx]) + ((uint32_t) source[idx]);
+        destination[idx] = (uint16_t) ((bin > 0xFFFF) ? 0xFFFF : bin);
+    }
+}
+#endif
+
+/*******************************************************************/
+static void _SEN15901_copy_histogram(const uint16_t* source, uint16_t* destination, uint8_t bins_number) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Copy all bins.
+    for (idx = 0; idx < bins_number; idx++) {
+        destination[idx] = source[idx];
+    }
+}
+#endif
+
+/*******************************************************************/
+static void _SEN15901_add_wind_speed(SEN15901_measurements_t* measurements, uint32_t wind_speed_mh, uint8_t window_seconds) {
+#ifdef SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS
+    // Local variables.
+    uint32_t wind_speed_bin = 0;
+#endif
+    // Update peak value if required.
+    if (wind_speed_mh > measurements->wind_speed_mh_peak) {
+        measurements->wind_speed_mh_peak = wind_speed_mh;
+    }
+    // Update average value (weighted by the window duration).
+    measurements->wind_speed_mh_sum += ((uint64_t) wind_speed_mh) * ((uint64_t) window_seconds);
+    measurements->wind_speed_data_count += window_seconds;
+#ifdef SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS
+    // Update distribution, last bin includes all higher speeds.
+    wind_speed_bin = (wind_speed_mh / SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BIN_WIDTH_MH);
+    if (wind_speed_bin >= SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS) {
+        wind_speed_bin = (SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS - 1);
+    }
+    _SEN15901_increment_histogram_bin(&(measurements->wind_speed_histogram[wind_speed_bin]));
+#endif
+}
+
+#ifdef SEN15901_DRIVER_ADAPTIVE_SAMPLING
+/*******************************************************************/
+static void _SEN15901_reset_adaptive_sampling(SEN15901_adaptive_sampling_t* adaptive_sampling) {
+    // Restart from the shortest periods.
+    adaptive_sampling->wind_speed_period_seconds = adaptive_sampling->wind_speed_period_min_seconds;
+    adaptive_sampling->wind_direction_period_seconds = adaptive_sampling->wind_direction_period_min_seconds;
+    adaptive_sampling->wind_direction_last_valid = 0;
+    adaptive_sampling->stable_samples_count = 0;
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_double_sampling_period(uint8_t period_seconds, uint8_t period_max_seconds) {
+    // Local variables.
+    uint16_t period = (uint16_t) (period_seconds << 1);
+    // Saturate to the maximum.
+    return (uint8_t) ((period > period_max_seconds) ? period_max_seconds : period);
+}
+
+/*******************************************************************/
+static void _SEN15901_adapt_sampling_periods(SEN15901_adaptive_sampling_t* adaptive_sampling, uint8_t stable_flag) {
+    // Shorten both periods at once when conditions change.
+    if (stable_flag == 0) {
+        adaptive_sampling->wind_speed_period_seconds = adaptive_sampling->wind_speed_period_min_seconds;
+        adaptive_sampling->wind_direction_period_seconds = adaptive_sampling->wind_direction_period_min_seconds;
+        adaptive_sampling->stable_samples_count = 0;
+        return;
+    }
+    // Lengthen them progressively while conditions are stable.
+    adaptive_sampling->stable_samples_count++;
+    if ((adaptive_sampling->stable_samples_count) < SEN15901_ADAPTIVE_SAMPLING_STABLE_SAMPLES) return;
+    adaptive_sampling->stable_samples_count = 0;
+    adaptive_sampling->wind_speed_period_seconds = _SEN15901_double_sampling_period(adaptive_sampling->wind_speed_period_seconds, adaptive_sampling->wind_speed_period_max_seconds);
+    adaptive_sampling->wind_direction_period_seconds = _SEN15901_double_sampling_period(adaptive_sampling->wind_direction_period_seconds, adaptive_sampling->wind_direction_period_max_seconds);
+}
+
+/*******************************************************************/
+static void _SEN15901_adapt_wind_speed_sampling(SEN15901_context_t* context, uint32_t wind_speed_mh) {
+    // Local variables.
+    uint32_t wind_speed_mh_last = context->wind_speed_mh_last;
+    uint32_t delta_mh = (wind_speed_mh > wind_speed_mh_last) ? (wind_speed_mh - wind_speed_mh_last) : (wind_speed_mh_last - wind_speed_mh);
+    uint32_t delta_max_mh = (wind_speed_mh_last >> SEN15901_ADAPTIVE_SAMPLING_WIND_SPEED_DELTA_SHIFT);
+    // Compare speed change to the previous sample.
+    if (delta_max_mh < SEN15901_ADAPTIVE_SAMPLING_WIND_SPEED_DELTA_MIN_MH) {
+        delta_max_mh = SEN15901_ADAPTIVE_SAMPLING_WIND_SPEED_DELTA_MIN_MH;
+    }
+    _SEN15901_adapt_sampling_periods(&(context->adaptive_sampling), (delta_mh > delta_max_mh) ? 0 : 1);
+}
+
+/*******************************************************************/
+static void _SEN15901_adapt_wind_direction_sampling(SEN15901_context_t* context, uint8_t wind_direction_index) {
+    // Local variables.
+    SEN15901_adaptive_sampling_t* adaptive_sampling = &(context->adaptive_sampling);
+    int32_t wind_direction_degrees = (int32_t) SEN15901_WIND_DIRECTION_ANGLE_DEGREES[wind_direction_index];
+    int32_t delta_degrees = 0;
+    uint8_t stable_flag = 1;
+    // Compare direction change to the previous sample on the shortest arc.
+    if ((adaptive_sampling->wind_direction_last_valid) != 0) {
+        delta_degrees = wind_direction_degrees - ((int32_t) (adaptive_sampling->wind_direction_degrees_last));
+        if (delta_degrees < 0) {
+            delta_degrees = (-delta_degrees);
+        }
+        if (delta_degrees > 180) {
+            delta_degrees = (360 - delta_degrees);
+        }
+        stable_flag = (delta_degrees > SEN15901_ADAPTIVE_SAMPLING_WIND_DIRECTION_DELTA_DEGREES) ? 0 : 1;
+    }
+    adaptive_sampling->wind_direction_degrees_last = (uint16_t) wind_direction_degrees;
+    adaptive_sampling->wind_direction_last_valid = 1;
+    _SEN15901_adapt_sampling_periods(adaptive_sampling, stable_flag);
+}
+#endif
+
+/*******************************************************************/
+static void _SEN15901_add_wind_direction(SEN15901_measurements_t* measurements, uint8_t wind_direction_index, uint32_t wind_speed_mh) {
+    // Add new vector weighted by speed.
+    _SEN15901_add_wind_direction_vector(measurements, (int32_t) (wind_speed_mh / 1000), SEN15901_WIND_DIRECTION_ANGLE_DEGREES[wind_direction_index]);
+#ifdef SEN15901_DRIVER_WIND_ROSE
+    _SEN15901_increment_histogram_bin(&(measurements->wind_rose[SEN15901_WIND_DIRECTION_ROSE_SECTOR[wind_direction_index]]));
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+    // Add unit vector (not weighted by speed).
+    measurements->wind_direction_unit_sum_x += (int64_t) MATH_COS_TABLE[SEN15901_WIND_DIRECTION_ANGLE_DEGREES[wind_direction_index]];
+    measurements->wind_direction_unit_sum_y += (int64_t) MATH_SIN_TABLE[SEN15901_WIND_DIRECTION_ANGLE_DEGREES[wind_direction_index]];
+    measurements->wind_direction_data_count++;
+#endif
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_add_wind_direction_sample(SEN15901_context_t* context, int32_t* wind_direction_ratios_permille, uint32_t wind_speed_mh) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint8_t wind_direction_index = 0;
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING
+    uint8_t sector_count[SEN15901_WIND_DIRECTIONS_NUMBER] = { 0 };
+    uint8_t sector_count_max = 0;
+    uint8_t idx = 0;
+    // Decode all ratios and keep the most frequent direction.
+    for (idx = 0; idx < SEN15901_WIND_DIRECTION_SAMPLES_NUMBER; idx++) {
+        if (_SEN15901_get_wind_direction_index(context, wind_direction_ratios_permille[idx], &wind_direction_index) != SEN15901_SUCCESS) {
+            context->wind_direction_rejected_count++;
+            continue;
+        }
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION
+        _SEN15901_learn_wind_direction(context, wind_direction_index, wind_direction_ratios_permille[idx]);
+#endif
+        sector_count[wind_direction_index]++;
+        if (sector_count[wind_direction_index] > sector_count_max) {
+            sector_count_max = sector_count[wind_direction_index];
+        }
+    }
+    // Skip sample if all ratios were rejected.
+    if (sector_count_max == 0) goto errors;
+    for (wind_direction_index = 0; wind_direction_index < SEN15901_WIND_DIRECTIONS_NUMBER; wind_direction_index++) {
+        if (sector_count[wind_direction_index] == sector_count_max) break;
+    }
+#else
+    // Convert ratio to direction.
+    status = _SEN15901_get_wind_direction_index(context, wind_direction_ratios_permille[0], &wind_direction_index);
+    if (status != SEN15901_SUCCESS) goto errors;
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION
+    _SEN15901_learn_wind_direction(context, wind_direction_index, wind_direction_ratios_permille[0]);
+#endif
+#endif
+#ifdef SEN15901_DRIVER_ADAPTIVE_SAMPLING
+    _SEN15901_adapt_wind_direction_sampling(context, wind_direction_index);
+#endif
+    // Add sample to the active bank.
+    _SEN15901_add_wind_direction(context->measurements, wind_direction_index, wind_speed_mh);
+#ifdef SEN15901_DRIVER_AGGREGATION
+    _SEN15901_add_wind_direction(&(context->aggregation_current[SEN15901_AGGREGATION_LEVEL_1_MINUTE]), wind_direction_index, wind_speed_mh);
+#endif
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static void _SEN15901_get_wind_direction_trend_point(SEN15901_measurements_t* measurements, int32_t* trend_point_x, int32_t* trend_point_y) {
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    // Local variables.
+    int64_t x = (measurements->wind_direction_trend_point_x);
+    int64_t y = (measurements->wind_direction_trend_point_y);
+    // Scale trend point down to 32 bits, the angle is unchanged.
+    while ((x > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (x < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT)) || (y > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (y < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT))) {
+        x >>= 1;
+        y >>= 1;
+    }
+    (*trend_point_x) = (int32_t) x;
+    (*trend_point_y) = (int32_t) y;
+#else
+    (*trend_point_x) = (measurements->wind_direction_trend_point_x);
+    (*trend_point_y) = (measurements->wind_direction_trend_point_y);
+#endif
+}
+
+/*******************************************************************/
+static void _SEN15901_reset_measurements_bank(SEN15901_measurements_t* measurements) {
+#if ((defined SEN15901_DRIVER_WIND_ROSE) || (defined SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS))
+    // Local variables.
+    uint8_t idx = 0;
+#endif
+    // Wind speed.
+    measurements->wind_speed_data_count = 0;
+    measurements->wind_speed_mh_sum = 0;
+    measurements->wind_speed_mh_peak = 0;
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    measurements->wind_gust_edge_sum_max = 0;
+#endif
+#ifdef SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS
+    for (idx = 0; idx < SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS; idx++) {
+        measurements->wind_speed_histogram[idx] = 0;
+    }
+#endif
+    // Wind direction.
+#ifdef SEN15901_DRIVER_WIND_ROSE
+    for (idx = 0; idx < SEN15901_WIND_ROSE_SECTORS_NUMBER; idx++) {
+        measurements->wind_rose[idx] = 0;
+    }
+#endif
+    measurements->wind_direction_trend_point_x = 0;
+    measurements->wind_direction_trend_point_y = 0;
+#ifndef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    measurements->wind_direction_trend_point_shift = 0;
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+    measurements->wind_direction_data_count = 0;
+    measurements->wind_direction_unit_sum_x = 0;
+    measurements->wind_direction_unit_sum_y = 0;
+#endif
+    // Rainfall.
+    measurements->rain_edge_count = 0;
+}
+
+#ifdef SEN15901_DRIVER_AGGREGATION
+/*******************************************************************/
+static void _SEN15901_merge_measurements_bank(SEN15901_measurements_t* parent, SEN15901_measurements_t* child) {
+#ifndef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    // Local variables.
+    int64_t trend_point_x = 0;
+    int64_t trend_point_y = 0;
+#endif
+    // Wind speed.
+    parent->wind_speed_data_count += child->wind_speed_data_count;
+    parent->wind_speed_mh_sum += child->wind_speed_mh_sum;
+    if ((child->wind_speed_mh_peak) > (parent->wind_speed_mh_peak)) {
+        parent->wind_speed_mh_peak = child->wind_speed_mh_peak;
+    }
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    if ((child->wind_gust_edge_sum_max) > (parent->wind_gust_edge_sum_max)) {
+        parent->wind_gust_edge_sum_max = child->wind_gust_edge_sum_max;
+    }
+#endif
+#ifdef SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS
+    _SEN15901_merge_histogram(child->wind_speed_histogram, parent->wind_speed_histogram, SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS);
+#endif
+    // Wind direction.
+#ifdef SEN15901_DRIVER_WIND_ROSE
+    _SEN15901_merge_histogram(child->wind_rose, parent->wind_rose, SEN15901_WIND_ROSE_SECTORS_NUMBER);
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    parent->wind_direction_trend_point_x += child->wind_direction_trend_point_x;
+    parent->wind_direction_trend_point_y += child->wind_direction_trend_point_y;
+#else
+    // Bring both trend points to the coarsest scale before adding them.
+    if ((child->wind_direction_trend_point_shift) > (parent->wind_direction_trend_point_shift)) {
+        parent->wind_direction_trend_point_x >>= ((child->wind_direction_trend_point_shift) - (parent->wind_direction_trend_point_shift));
+        parent->wind_direction_trend_point_y >>= ((child->wind_direction_trend_point_shift) - (parent->wind_direction_trend_point_shift));
+        parent->wind_direction_trend_point_shift = child->wind_direction_trend_point_shift;
+    }
+    trend_point_x = ((int64_t) parent->wind_direction_trend_point_x) + (((int64_t) child->wind_direction_trend_point_x) >> ((parent->wind_direction_trend_point_shift) - (child->wind_direction_trend_point_shift)));
+    trend_point_y = ((int64_t) parent->wind_direction_trend_point_y) + (((int64_t) child->wind_direction_trend_point_y) >> ((parent->wind_direction_trend_point_shift) - (child->wind_direction_trend_point_shift)));
+    // Halve the sum until it fits the limit again.
+    while ((trend_point_x > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (trend_point_x < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT)) ||
+           (trend_point_y > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (trend_point_y < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT))) {
+        trend_point_x >>= 1;
+        trend_point_y >>= 1;
+        parent->wind_direction_trend_point_shift++;
+    }
+    parent->wind_direction_trend_point_x = (int32_t) trend_point_x;
+    parent->wind_direction_trend_point_y = (int32_t) trend_point_y;
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+    parent->wind_direction_data_count += child->wind_direction_data_count;
+    parent->wind_direction_unit_sum_x += child->wind_direction_unit_sum_x;
+    parent->wind_direction_unit_sum_y += child->wind_direction_unit_sum_y;
+#endif
+    // Rainfall.
+    parent->rain_edge_count += child->rain_edge_count;
+}
+
+/*******************************************************************/
+static void _SEN15901_update_aggregation(SEN15901_context_t* context) {
+    // Local variables.
+    uint32_t clock_seconds = context->aggregation_clock_seconds;
+    uint8_t level = 0;
+    // Close each elapsed minute.
+    while ((clock_seconds - (context->aggregation_clock_seconds_read)) >= SEN15901_AGGREGATION_LEVEL_1_MINUTE_SECONDS) {
+        context->aggregation_clock_seconds_read += SEN15901_AGGREGATION_LEVEL_1_MINUTE_SECONDS;
+        for (level = 0; level < SEN15901_AGGREGATION_LEVEL_LAST; level++) {
+            // Publish completed interval and start a new one.
+            context->aggregation_completed[level] = context->aggregation_current[level];
+            _SEN15901_reset_measurements_bank(&(context->aggregation_current[level]));
+            if ((level + 1) >= SEN15901_AGGREGATION_LEVEL_LAST) break;
+            // Fold completed interval into the parent level, which is closed in turn once all its children are completed.
+            _SEN15901_merge_measurements_bank(&(context->aggregation_current[level + 1]), &(context->aggregation_completed[level]));
+            context->aggregation_children_count[level]++;
+            if ((context->aggregation_children_count[level]) < SEN15901_AGGREGATION_CHILDREN_NUMBER[level]) break;
+            context->aggregation_children_count[level] = 0;
+        }
+    }
+}
+#endif
+
+/*******************************************************************/
+static void _SEN15901_update_rainfall(SEN15901_context_t* context) {
+    // Local variables.
+    uint32_t rain_edge_count = 0;
+    // Move pending edges to the active bank.
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+    rain_edge_count = _SEN15901_edge_ring_drain(&(context->rain_edge_ring), NULL, NULL);
+#else
+    rain_edge_count = (context->rain_edge_count - context->rain_edge_count_read);
+    context->rain_edge_count_read += rain_edge_count;
+#endif
+    context->measurements->rain_edge_count += rain_edge_count;
+#ifdef SEN15901_DRIVER_AGGREGATION
+    context->aggregation_current[SEN15901_AGGREGATION_LEVEL_1_MINUTE].rain_edge_count += rain_edge_count;
+#endif
+}
+
+/*******************************************************************/
+static uint32_t _SEN15901_get_rain_edge_count_pending(SEN15901_context_t* context) {
+    // Edges not yet moved to the active bank.
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+    return ((context->rain_edge_ring.head - context->rain_edge_ring.tail) + (context->rain_edge_ring.overflow_count - context->rain_edge_ring.overflow_count_read));
+#else
+    return (context->rain_edge_count - context->rain_edge_count_read);
+#endif
+}
+
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+/*******************************************************************/
+static int32_t _SEN15901_get_rain_rate(SEN15901_context_t* context, SEN15901_rain_rate_window_t window) {
+    // Convert tips count of the window to micrometers per hour (product computed on 64 bits, tips count is bounded by the ring size).
+    return (int32_t) ((((uint64_t) (context->rain_tip_head_read - context->rain_tip_window_tail[window])) * SEN15901_RAIN_EDGE_TO_UM * 3600) / (SEN15901_RAIN_RATE_WINDOW_SECONDS[window]));
+}
+
+/*******************************************************************/
+static void _SEN15901_update_rain_rate(SEN15901_context_t* context) {
+    // Local variables.
+    uint32_t clock_seconds = context->rain_rate_clock_seconds;
+    uint32_t rain_tip_head = context->rain_tip_head;
+    int32_t rain_rate_um_h = 0;
+#ifdef SEN15901_DRIVER_TICKLESS
+    uint32_t deadline_seconds = 0;
+    uint32_t expiry_seconds = 0;
+    uint8_t deadline_flag = 0;
+#endif
+    uint8_t idx = 0;
+    // Tips timestamped by the interrupt up to now.
+    context->rain_tip_head_read = rain_tip_head;
+    for (idx = 0; idx < SEN15901_RAIN_RATE_WINDOW_LAST; idx++) {
+        // Drop overwritten tips.
+        if ((rain_tip_head - context->rain_tip_window_tail[idx]) > SEN15901_DRIVER_RAIN_RATE_RING_SIZE) {
+            context->rain_tip_window_tail[idx] = (rain_tip_head - SEN15901_DRIVER_RAIN_RATE_RING_SIZE);
+        }
+        // Remove expired tips.
+        while ((context->rain_tip_window_tail[idx] != rain_tip_head) &&
+               ((clock_seconds - context->rain_tip_seconds[(context->rain_tip_window_tail[idx]) & SEN15901_RAIN_RATE_RING_MASK]) >= SEN15901_RAIN_RATE_WINDOW_SECONDS[idx])) {
+            context->rain_tip_window_tail[idx]++;
+        }
+#ifdef SEN15901_DRIVER_TICKLESS
+        // Follow the 1 minute window every second while it is raining, and the longer windows up to the expiry of their oldest tip.
+        if (context->rain_tip_window_tail[idx] != rain_tip_head) {
+            expiry_seconds = (idx == SEN15901_RAIN_RATE_WINDOW_1_MINUTE) ? (clock_seconds + 1) : (context->rain_tip_seconds[(context->rain_tip_window_tail[idx]) & SEN15901_RAIN_RATE_RING_MASK] + SEN15901_RAIN_RATE_WINDOW_SECONDS[idx]);
+            if ((deadline_flag == 0) || (((int32_t) (expiry_seconds - deadline_seconds)) < 0)) {
+                deadline_seconds = expiry_seconds;
+                deadline_flag = 1;
+            }
+        }
+#endif
+    }
+#ifdef SEN15901_DRIVER_TICKLESS
+    // Publish the first expiry before the tips head it covers, so that the tick never stops the timer on an outdated deadline.
+    context->rain_rate_deadline_seconds = deadline_seconds;
+    context->rain_rate_deadline_flag = deadline_flag;
+    context->rain_rate_deadline_tip_head = rain_tip_head;
+#endif
+    // Check alert threshold on the shortest window.
+    if (context->rain_rate_alert_callback == NULL) return;
+    rain_rate_um_h = _SEN15901_get_rain_rate(context, SEN15901_RAIN_RATE_WINDOW_1_MINUTE);
+    if (rain_rate_um_h < (context->rain_rate_alert_threshold_um_h)) {
+        context->rain_rate_alert_flag = 0;
+    }
+    else if (context->rain_rate_alert_flag == 0) {
+        // Call once per threshold crossing.
+        context->rain_rate_alert_flag = 1;
+        // Measurements are consistent here, so that the callback can call the getters.
+        SEN15901_WRITE_TOGGLE(context);
+        context->rain_rate_alert_callback(rain_rate_um_h);
+        SEN15901_WRITE_TOGGLE(context);
+    }
+}
+#endif
+
+/*******************************************************************/
+static void _SEN15901_get_wind_speed(SEN15901_measurements_t* measurements, int32_t* average_speed_mh, int32_t* peak_speed_mh) {
+    // Compute average only when read.
+    (*average_speed_mh) = 0;
+    if ((measurements->wind_speed_data_count) != 0) {
+        (*average_speed_mh) = (int32_t) ((measurements->wind_speed_mh_sum) / ((uint64_t) (measurements->wind_speed_data_count)));
+    }
+    (*peak_speed_mh) = (int32_t) (measurements->wind_speed_mh_peak);
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_get_wind_direction(SEN15901_measurements_t* measurements, int32_t* average_direction_degrees, SEN15901_wind_direction_status_t* direction_status) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    MATH_status_t math_status = MATH_SUCCESS;
+    int32_t trend_point_x = 0;
+    int32_t trend_point_y = 0;
+    // Reset output status.
+    (*direction_status) = SEN15901_WIND_DIRECTION_STATUS_UNDEFINED;
+    // Check trend point coordinates.
+    _SEN15901_get_wind_direction_trend_point(measurements, &trend_point_x, &trend_point_y);
+    if ((trend_point_x != 0) || (trend_point_y != 0)) {
+        // Compute trend point angle.
+        math_status = MATH_atan2(trend_point_x, trend_point_y, average_direction_degrees);
+        MATH_exit_error(SEN15901_ERROR_BASE_MATH);
+        // Update output status.
+        (*direction_status) = SEN15901_WIND_DIRECTION_STATUS_AVAILABLE;
+    }
+errors:
+    return status;
+}
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+/*******************************************************************/
+static uint32_t _SEN15901_square_root(uint64_t value) {
+    // Local variables.
+    uint64_t result = 0;
+    uint64_t bit = ((uint64_t) 1) << 62;
+    // Bitwise integer square root.
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= (result + bit)) {
+            value -= (result + bit);
+            result = (result >> 1) + bit;
+        }
+        else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t) result;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_get_wind_direction_sigma(SEN15901_measurements_t* measurements, int32_t* sigma_degrees, SEN15901_wind_direction_status_t* direction_status) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    MATH_status_t math_status = MATH_SUCCESS;
+    uint64_t unit = (uint64_t) MATH_COS_TABLE[0];
+    uint64_t unit_cube = (unit * unit * unit);
+    int64_t count = (int64_t) (measurements->wind_direction_data_count);
+    int64_t mean_x = 0;
+    int64_t mean_y = 0;
+    uint64_t resultant_square = 0;
+    uint64_t epsilon = 0;
+    int32_t asin_epsilon_degrees = 0;
+    // Reset output.
+    (*sigma_degrees) = 0;
+    (*direction_status) = SEN15901_WIND_DIRECTION_STATUS_UNDEFINED;
+    if ((measurements->wind_direction_data_count) == 0) goto errors;
+    // Mean unit vector with extra fractional bits, sums of 2^32 samples of 16-bit table values still fit once scaled.
+    mean_x = (((measurements->wind_direction_unit_sum_x) * SEN15901_WIND_DIRECTION_SIGMA_MEAN_SCALE) / count);
+    mean_y = (((measurements->wind_direction_unit_sum_y) * SEN15901_WIND_DIRECTION_SIGMA_MEAN_SCALE) / count);
+    // Squared mean resultant length and epsilon = sqrt(1 - R^2), both scaled by the trigonometric tables unit.
+    resultant_square = (((uint64_t) ((mean_x * mean_x) + (mean_y * mean_y))) / (((uint64_t) SEN15901_WIND_DIRECTION_SIGMA_MEAN_SCALE) * SEN15901_WIND_DIRECTION_SIGMA_MEAN_SCALE));
+    if (resultant_square > (unit * unit)) {
+        resultant_square = (unit * unit);
+    }
+    epsilon = (uint64_t) _SEN15901_square_root((unit * unit) - resultant_square);
+    // asin(epsilon) = atan2(epsilon, R).
+    math_status = MATH_atan2((int32_t) _SEN15901_square_root(resultant_square), (int32_t) epsilon, &asin_epsilon_degrees);
+    MATH_exit_error(SEN15901_ERROR_BASE_MATH);
+    // Yamartino: sigma = asin(epsilon) * (1 + (2 / sqrt(3) - 1) * epsilon^3).
+    (*sigma_degrees) = (int32_t) ((((uint64_t) asin_epsilon_degrees) * ((1000 * unit_cube) + (155 * epsilon * epsilon * epsilon))) / (1000 * unit_cube));
+    (*direction_status) = SEN15901_WIND_DIRECTION_STATUS_AVAILABLE;
+errors:
+    return status;
+}
+#endif
+
+#if ((defined SEN15901_DRIVER_TICKLESS) && ((defined SEN15901_DRIVER_EDGE_DEBOUNCE) || (defined SEN15901_DRIVER_RAIN_RATE_RING_SIZE)))
+/*******************************************************************/
+static void _SEN15901_request_wakeup(SEN15901_context_t* context) {
+    // Start a 1 second wake-up from interrupt context when the timer is stopped, a running timer already leads to the next tick.
+    if ((context->wakeup_delay_seconds) != 0) return;
+    context->wakeup_delay_seconds = 1;
+    SEN15901_HW_set_wakeup_timer(context, 1);
+}
+#endif
+
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+/*******************************************************************/
+static void _SEN15901_set_edge_guard_debounce(SEN15901_edge_guard_t* guard, uint32_t debounce_us) {
+    // Storm threshold per second derived from the maximum valid edges rate.
+    guard->storm_edge_count_max = (debounce_us == 0) ? 0 : ((SEN15901_EDGE_STORM_FACTOR * 1000000) / debounce_us);
+    guard->debounce_us = debounce_us;
+}
+
+/*******************************************************************/
+static void _SEN15901_reset_edge_guard(SEN15901_edge_guard_t* guard, uint32_t debounce_us) {
+    _SEN15901_set_edge_guard_debounce(guard, debounce_us);
+    guard->edge_last_us = 0;
+    guard->edge_last_valid = 0;
+    guard->interrupt_enable_flag = 0;
+    guard->masked_flag = 0;
+    guard->tick_edge_count = 0;
+    guard->bounce_count = 0;
+    guard->storm_count = 0;
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_filter_edge(SEN15901_context_t* context, SEN15901_edge_guard_t* guard, uint32_t timestamp_us, SEN15901_status_t (*set_interrupt)(SEN15901_context_t* context, uint8_t enable)) {
+    // Local variables.
+    uint32_t storm_edge_count_max = guard->storm_edge_count_max;
+    // Check if filtering is enabled.
+    if ((guard->debounce_us) == 0) return 1;
+#ifdef SEN15901_DRIVER_TICKLESS
+    // Threshold applies to the whole wake-up period.
+    if ((context->wakeup_delay_seconds) > 1) {
+        storm_edge_count_max *= (context->wakeup_delay_seconds);
+    }
+#endif
+    // Mask the input until next tick when the raw edges rate is physically impossible.
+    guard->tick_edge_count++;
+#ifdef SEN15901_DRIVER_TICKLESS
+    // The detection period starts with the first edge when the timer is stopped, and ends with the tick which unmasks the input.
+    _SEN15901_request_wakeup(context);
+#endif
+    if ((guard->tick_edge_count) > storm_edge_count_max) {
+        if (guard->masked_flag == 0) {
+            set_interrupt(context, 0);
+            guard->masked_flag = 1;
+            guard->storm_count++;
+        }
+        return 0;
+    }
+    // Reject edges closer than the debounce interval.
+    if ((guard->edge_last_valid != 0) && ((timestamp_us - (guard->edge_last_us)) < (guard->debounce_us))) {
+        guard->bounce_count++;
+        return 0;
+    }
+    guard->edge_last_us = timestamp_us;
+    guard->edge_last_valid = 1;
+    return 1;
+}
+
+/*******************************************************************/
+static void _SEN15901_restart_edge_guard(SEN15901_context_t* context, SEN15901_edge_guard_t* guard, SEN15901_status_t (*set_interrupt)(SEN15901_context_t* context, uint8_t enable)) {
+    // Local variables.
+    uint32_t tick_edge_count = guard->tick_edge_count;
+    // Start a new storm detection period.
+    SEN15901_SHARED_CONSUME(guard->tick_edge_count, tick_edge_count);
+    if (guard->masked_flag != 0) {
+        guard->masked_flag = 0;
+        // Unmask input if it has not been disabled in the meantime.
+        if (guard->interrupt_enable_flag != 0) {
+            set_interrupt(context, 1);
+        }
+    }
+}
+#endif
+
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+/*******************************************************************/
+static void _SEN15901_reset_instrumentation(SEN15901_context_t* context) {
+    // Interrupts.
+    context->instrumentation_wind_speed_edge_irq_count = 0;
+    context->instrumentation_rainfall_edge_irq_count = 0;
+    context->instrumentation_tick_second_irq_count = 0;
+    context->instrumentation_tick_gust_irq_count = 0;
+    context->instrumentation_adc_done_irq_count = 0;
+    context->instrumentation_wind_speed_edge_rate_max = 0;
+    context->instrumentation_rainfall_edge_rate_max = 0;
+    context->instrumentation_wind_speed_edge_second_count = 0;
+    context->instrumentation_rainfall_edge_second_count = 0;
+    // Process function.
+    context->instrumentation_process_call_count = 0;
+    context->instrumentation_process_cycles_min = 0;
+    context->instrumentation_process_cycles_max = 0;
+    context->instrumentation_process_cycles_total = 0;
+    context->instrumentation_process_cycle_valid = 0;
+}
+
+/*******************************************************************/
+static void _SEN15901_update_instrumentation_edge_rates(SEN15901_context_t* context, uint32_t seconds) {
+    // Local variables.
+    uint32_t edge_count = 0;
+    uint32_t edge_rate = 0;
+    // Edges count since previous tick divided by the elapsed time.
+    if (seconds == 0) return;
+    edge_count = context->instrumentation_wind_speed_edge_second_count;
+    SEN15901_SHARED_CONSUME(context->instrumentation_wind_speed_edge_second_count, edge_count);
+    edge_rate = (edge_count / seconds);
+    if (edge_rate > context->instrumentation_wind_speed_edge_rate_max) {
+        context->instrumentation_wind_speed_edge_rate_max = edge_rate;
+    }
+    edge_count = context->instrumentation_rainfall_edge_second_count;
+    SEN15901_SHARED_CONSUME(context->instrumentation_rainfall_edge_second_count, edge_count);
+    edge_rate = (edge_count / seconds);
+    if (edge_rate > context->instrumentation_rainfall_edge_rate_max) {
+        context->instrumentation_rainfall_edge_rate_max = edge_rate;
+    }
+}
+
+/*******************************************************************/
+static void _SEN15901_start_instrumentation_process(SEN15901_context_t* context) {
+    // Durations are only recorded when the cycle counter is implemented.
+    context->instrumentation_process_cycle_valid = (SEN15901_HW_get_cycle_count(context, &(context->instrumentation_process_cycle_start)) == SEN15901_SUCCESS) ? 1 : 0;
+}
+
+/*******************************************************************/
+static void _SEN15901_stop_instrumentation_process(SEN15901_context_t* context) {
+    // Local variables.
+    uint32_t cycle_count = 0;
+    uint32_t process_cycles = 0;
+    // Check context (process function may exit before start).
+    if (context == NULL) return;
+    context->instrumentation_process_call_count++;
+    if (context->instrumentation_process_cycle_valid == 0) return;
+    context->instrumentation_process_cycle_valid = 0;
+    if (SEN15901_HW_get_cycle_count(context, &cycle_count) != SEN15901_SUCCESS) return;
+    // Counter is free running, wrap around is handled by unsigned subtraction.
+    process_cycles = (cycle_count - (context->instrumentation_process_cycle_start));
+    if ((process_cycles < (context->instrumentation_process_cycles_min)) || ((context->instrumentation_process_cycles_total) == 0)) {
+        context->instrumentation_process_cycles_min = process_cycles;
+    }
+    if (process_cycles > (context->instrumentation_process_cycles_max)) {
+        context->instrumentation_process_cycles_max = process_cycles;
+    }
+    context->instrumentation_process_cycles_total += (uint64_t) process_cycles;
+}
+#endif
+
+/*******************************************************************/
+static void _SEN15901_wind_speed_edge_callback(SEN15901_context_t* context) {
+#if ((defined SEN15901_DRIVER_EDGE_RING_SIZE) || (defined SEN15901_DRIVER_EDGE_DEBOUNCE))
+    // Local variables.
+    uint32_t timestamp_us = 0;
+#endif
+    SEN15901_INSTRUMENTATION_EDGE(context, wind_speed);
+#if ((defined SEN15901_DRIVER_EDGE_RING_SIZE) || (defined SEN15901_DRIVER_EDGE_DEBOUNCE))
+    SEN15901_HW_get_timestamp_us(context, &timestamp_us);
+#endif
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+    if (_SEN15901_filter_edge(context, &(context->wind_speed_edge_guard), timestamp_us, &SEN15901_HW_set_wind_speed_interrupt) == 0) return;
+#endif
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+    // Push edge timestamp.
+    _SEN15901_edge_ring_push(&(context->wind_speed_edge_ring), timestamp_us);
+#else
+    // Wind speed.
+    context->wind_speed_edge_count++;
+#endif
+}
+
+/*******************************************************************/
+static void _SEN15901_rainfall_edge_callback(SEN15901_context_t* context) {
+#if ((defined SEN15901_DRIVER_EDGE_RING_SIZE) || (defined SEN15901_DRIVER_EDGE_DEBOUNCE))
+    // Local variables.
+    uint32_t timestamp_us = 0;
+#endif
+    SEN15901_INSTRUMENTATION_EDGE(context, rainfall);
+#if ((defined SEN15901_DRIVER_EDGE_RING_SIZE) || (defined SEN15901_DRIVER_EDGE_DEBOUNCE))
+    SEN15901_HW_get_timestamp_us(context, &timestamp_us);
+#endif
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+    if (_SEN15901_filter_edge(context, &(context->rain_edge_guard), timestamp_us, &SEN15901_HW_set_rainfall_interrupt) == 0) return;
+#endif
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+    // Push edge timestamp.
+    _SEN15901_edge_ring_push(&(context->rain_edge_ring), timestamp_us);
+#else
+    // Increment edge count.
+    context->rain_edge_count++;
+#endif
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+#ifdef SEN15901_DRIVER_TICKLESS
+    // Start the clock when the timer is stopped, and timestamp tip with the second ending at the next wake-up, where the clock is advanced.
+    _SEN15901_request_wakeup(context);
+    context->rain_tip_seconds[(context->rain_tip_head) & SEN15901_RAIN_RATE_RING_MASK] = (context->rain_rate_clock_seconds + context->wakeup_delay_seconds - 1);
+#else
+    // Timestamp tip when it occurs, the oldest ones are overwritten when the ring is full.
+    context->rain_tip_seconds[(context->rain_tip_head) & SEN15901_RAIN_RATE_RING_MASK] = context->rain_rate_clock_seconds;
+#endif
+    context->rain_tip_head++;
+#endif
+}
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+/*******************************************************************/
+static void _SEN15901_wind_direction_adc_done_callback(SEN15901_context_t* context) {
+    SEN15901_INSTRUMENTATION_IRQ(context, adc_done);
+    // Result is available in the context buffer.
+    context->wind_direction_adc_done_flag = 1;
+    // Ask for processing.
+    if (context->process_callback != NULL) {
+        context->process_callback(context);
+    }
+}
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT
+/*******************************************************************/
+static void _SEN15901_wind_speed_capture_callback(SEN15901_context_t* context, uint32_t capture_us) {
+    SEN15901_INSTRUMENTATION_EDGE(context, wind_speed);
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+    if (_SEN15901_filter_edge(context, &(context->wind_speed_edge_guard), capture_us, &SEN15901_HW_set_wind_speed_interrupt) == 0) return;
+#endif
+    // Push hardware captured edge timestamp.
+    _SEN15901_edge_ring_push(&(context->wind_speed_edge_ring), capture_us);
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_compute_wind_speed_period(SEN15901_context_t* context, uint32_t wind_speed_edge_count, uint32_t edge_last_us, uint32_t* wind_speed_mh) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t timestamp_us = 0;
+    uint32_t elapsed_us = 0;
+    uint32_t wind_speed_mh_max = 0;
+    // Check edges.
+    if (wind_speed_edge_count == 0) {
+        // No edge in the window: the speed is bounded by the time elapsed since the last edge.
+        if (context->wind_speed_edge_last_valid == 0) {
+            context->wind_speed_period_mh = 0;
+        }
+        else {
+            status = SEN15901_HW_get_timestamp_us(context, &timestamp_us);
+            if (status != SEN15901_SUCCESS) goto errors;
+            elapsed_us = (timestamp_us - (context->wind_speed_edge_last_us));
+            if (elapsed_us >= SEN15901_WIND_SPEED_PERIOD_TIMEOUT_US) {
+                context->wind_speed_edge_last_valid = 0;
+                context->wind_speed_period_mh = 0;
+            }
+            else {
+                wind_speed_mh_max = (uint32_t) ((((uint64_t) SEN15901_WIND_SPEED_1HZ_TO_MH) * 1000000) / ((uint64_t) elapsed_us));
+                if (wind_speed_mh_max < (context->wind_speed_period_mh)) {
+                    context->wind_speed_period_mh = wind_speed_mh_max;
+                }
+            }
+        }
+    }
+    else {
+        // Compute speed from the period between the previous last edge and the current last edge.
+        if (context->wind_speed_edge_last_valid == 0) {
+            // No reference edge yet (start or count mode): keep the count of the window.
+            context->wind_speed_period_mh = (*wind_speed_mh);
+        }
+        else {
+            elapsed_us = (edge_last_us - (context->wind_speed_edge_last_us));
+            if (elapsed_us != 0) {
+                context->wind_speed_period_mh = (uint32_t) ((((uint64_t) wind_speed_edge_count) * ((uint64_t) SEN15901_WIND_SPEED_1HZ_TO_MH) * 1000000) / ((uint64_t) elapsed_us));
+            }
+        }
+        context->wind_speed_edge_last_us = edge_last_us;
+        context->wind_speed_edge_last_valid = 1;
+    }
+    (*wind_speed_mh) = context->wind_speed_period_mh;
+errors:
+    return status;
+}
+#endif
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_compute_wind_speed(SEN15901_context_t* context, uint8_t window_seconds, uint32_t* wind_speed_mh) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t wind_speed_edge_count = 0;
+#ifdef SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT
+    uint32_t overflow_count = 0;
+    uint32_t edge_last_us = 0;
+#endif
+    // Read and reset edge count.
+#ifdef SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT
+    wind_speed_edge_count = _SEN15901_edge_ring_drain(&(context->wind_speed_edge_ring), &overflow_count, &edge_last_us);
+#elif (defined SEN15901_DRIVER_EDGE_RING_SIZE)
+    wind_speed_edge_count = _SEN15901_edge_ring_drain(&(context->wind_speed_edge_ring), NULL, NULL);
+#else
+    wind_speed_edge_count = (context->wind_speed_edge_count - context->wind_speed_edge_count_read);
+    context->wind_speed_edge_count_read += wind_speed_edge_count;
+#endif
+    // Count edges over the sampling window.
+    (*wind_speed_mh) = (wind_speed_edge_count * SEN15901_WIND_SPEED_1HZ_TO_MH) / ((uint32_t) window_seconds);
+#ifdef SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT
+    // Use edges period at low frequency, when all edges have been timestamped.
+    if ((wind_speed_edge_count <= SEN15901_WIND_SPEED_PERIOD_EDGE_COUNT_MAX(window_seconds)) && (overflow_count == 0)) {
+        status = _SEN15901_compute_wind_speed_period(context, wind_speed_edge_count, edge_last_us, wind_speed_mh);
+        if (status != SEN15901_SUCCESS) goto errors;
+    }
+    else {
+        // Restart period measurement from the next edge.
+        context->wind_speed_edge_last_valid = 0;
+        context->wind_speed_period_mh = (*wind_speed_mh);
+    }
+errors:
+#endif
+    return status;
+}
+
+#ifdef SEN15901_DRIVER_TICKLESS
+/*******************************************************************/
+static uint8_t _SEN15901_get_wakeup_delay(SEN15901_context_t* context) {
+    // Local variables.
+    uint8_t wind_speed_period = SEN15901_WIND_SPEED_SAMPLING_TIME_SECONDS(context);
+    uint8_t wind_direction_period = SEN15901_WIND_DIRECTION_SAMPLING_PERIOD_SECONDS(context);
+    uint8_t wind_speed_delay = wind_speed_period;
+    uint8_t wind_direction_delay = wind_direction_period;
+    uint32_t delay_seconds = SEN15901_WAKEUP_DELAY_NONE;
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+    uint32_t rain_rate_delay = SEN15901_WAKEUP_DELAY_NONE;
+#endif
+#ifdef SEN15901_DRIVER_AGGREGATION
+    uint32_t aggregation_delay = 0;
+#endif
+    // Remaining time of each wind period (counters are reset by the process function once reached).
+    if (context->wind_measurement_enable_flag != 0) {
+        if ((context->wind_speed_seconds_count) < wind_speed_period) {
+            wind_speed_delay = (uint8_t) (wind_speed_period - (context->wind_speed_seconds_count));
+        }
+        if ((context->wind_direction_seconds_count) < wind_direction_period) {
+            wind_direction_delay = (uint8_t) (wind_direction_period - (context->wind_direction_seconds_count));
+        }
+        delay_seconds = (wind_speed_delay < wind_direction_delay) ? wind_speed_delay : wind_direction_delay;
+    }
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+    // Unmask stormed inputs at the next second.
+    if ((context->wind_speed_edge_guard.masked_flag != 0) || (context->rain_edge_guard.masked_flag != 0)) {
+        delay_seconds = 1;
+    }
+#endif
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+    // Let the process function read the new tips, then wake-up when the oldest tip of a window expires.
+    if ((context->rain_tip_head) != (context->rain_rate_deadline_tip_head)) {
+        rain_rate_delay = 1;
+    }
+    else if (context->rain_rate_deadline_flag != 0) {
+        rain_rate_delay = (context->rain_rate_deadline_seconds - context->rain_rate_clock_seconds);
+        // Expired tips are removed by the pending process call.
+        if (((int32_t) rain_rate_delay) <= 0) {
+            rain_rate_delay = 1;
+        }
+    }
+    if (rain_rate_delay < delay_seconds) {
+        delay_seconds = rain_rate_delay;
+    }
+#endif
+#ifdef SEN15901_DRIVER_AGGREGATION
+    // Close each minute on its boundary (the process function reads the clock by steps of 1 minute from 0).
+    aggregation_delay = SEN15901_AGGREGATION_LEVEL_1_MINUTE_SECONDS - ((context->aggregation_clock_seconds) % SEN15901_AGGREGATION_LEVEL_1_MINUTE_SECONDS);
+    if (aggregation_delay < delay_seconds) {
+        delay_seconds = aggregation_delay;
+    }
+#endif
+    // Wake-up at the first deadline, or stop the timer.
+    if (delay_seconds == SEN15901_WAKEUP_DELAY_NONE) return 0;
+    return (delay_seconds > SEN15901_WAKEUP_DELAY_SECONDS_MAX) ? SEN15901_WAKEUP_DELAY_SECONDS_MAX : ((uint8_t) delay_seconds);
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_set_wakeup_timer(SEN15901_context_t* context) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint8_t delay_seconds = 0;
+    // Stop the timer first: an interrupt requesting a wake-up from now finds it stopped, or is seen by the deadline computation.
+    context->wakeup_delay_seconds = 0;
+    status = SEN15901_HW_set_wakeup_timer(context, 0);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Program the next deadline.
+    delay_seconds = _SEN15901_get_wakeup_delay(context);
+    if (delay_seconds == 0) goto errors;
+    context->wakeup_delay_seconds = delay_seconds;
+    status = SEN15901_HW_set_wakeup_timer(context, delay_seconds);
+errors:
+    return status;
+}
+#endif
+
+/*******************************************************************/
+static void _SEN15901_tick_second_callback(SEN15901_context_t* context) {
+    SEN15901_INSTRUMENTATION_IRQ(context, tick_second);
+#ifdef SEN15901_DRIVER_TICKLESS
+    SEN15901_INSTRUMENTATION_TICK(context, context->wakeup_delay_seconds);
+#else
+    SEN15901_INSTRUMENTATION_TICK(context, 1);
+#endif
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+    // Unmask stormed inputs.
+    _SEN15901_restart_edge_guard(context, &(context->wind_speed_edge_guard), &SEN15901_HW_set_wind_speed_interrupt);
+    _SEN15901_restart_edge_guard(context, &(context->rain_edge_guard), &SEN15901_HW_set_rainfall_interrupt);
+#endif
+    // Check enable flag.
+    if (context->wind_measurement_enable_flag != 0) {
+        // Update local flags.
+#ifdef SEN15901_DRIVER_TICKLESS
+        context->wind_speed_seconds_count += context->wakeup_delay_seconds;
+        context->wind_direction_seconds_count += context->wakeup_delay_seconds;
+#else
+        context->wind_speed_seconds_count++;
+        context->wind_direction_seconds_count++;
+#endif
+        context->tick_second_flag = 1;
+    }
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+    // Rain rate clock runs even without wind measurement.
+#ifdef SEN15901_DRIVER_TICKLESS
+    context->rain_rate_clock_seconds += context->wakeup_delay_seconds;
+#else
+    context->rain_rate_clock_seconds++;
+#endif
+    context->tick_second_flag = 1;
+#endif
+#ifdef SEN15901_DRIVER_AGGREGATION
+    // Aggregation clock runs even without wind measurement.
+#ifdef SEN15901_DRIVER_TICKLESS
+    context->aggregation_clock_seconds += context->wakeup_delay_seconds;
+#else
+    context->aggregation_clock_seconds++;
+#endif
+    context->tick_second_flag = 1;
+#endif
+#ifdef SEN15901_DRIVER_TICKLESS
+    // Program next deadline, the one-shot timer is stopped when there is none.
+    _SEN15901_set_wakeup_timer(context);
+#endif
+    // Ask for processing.
+    if ((context->tick_second_flag != 0) && (context->process_callback != NULL)) {
+        context->process_callback(context);
+    }
+}
+
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+/*******************************************************************/
+static void _SEN15901_tick_gust_callback(SEN15901_context_t* context) {
+    // Local variables.
+    uint32_t edge_count = 0;
+    uint32_t edge_count_new = 0;
+    uint8_t request = SEN15901_WIND_GUST_REQUEST_NONE;
+    SEN15901_INSTRUMENTATION_IRQ(context, tick_gust);
+    // Check enable flag.
+    if (context->wind_measurement_enable_flag != 0) {
+        // Start a new interval after a snapshot, the maximum of the closed one is kept for the snapshot function.
+        if (context->wind_gust_restart_flag != 0) {
+            context->wind_gust_edge_sum_max_closed = context->wind_gust_edge_sum_max_current;
+            context->wind_gust_edge_sum_max_current = 0;
+            context->wind_gust_restart_flag = 0;
+        }
+        // Compute edge count of the elapsed sample.
+        edge_count = _SEN15901_get_wind_speed_edge_count(context);
+        edge_count_new = (edge_count - (context->wind_gust_edge_count_read));
+        context->wind_gust_edge_count_read = edge_count;
+        // Update sliding sum in place of the oldest sample.
+        context->wind_gust_edge_sum -= context->wind_gust_edge_count[context->wind_gust_sample_index];
+        context->wind_gust_edge_sum += edge_count_new;
+        context->wind_gust_edge_count[context->wind_gust_sample_index] = (uint16_t) edge_count_new;
+        context->wind_gust_sample_index = (uint8_t) ((context->wind_gust_sample_index + 1) % SEN15901_WIND_GUST_SAMPLES_NUMBER);
+        // Wait for a full window before computing gusts.
+        if (context->wind_gust_samples_count < SEN15901_WIND_GUST_SAMPLES_NUMBER) {
+            context->wind_gust_samples_count++;
+        }
+        if (context->wind_gust_samples_count >= SEN15901_WIND_GUST_SAMPLES_NUMBER) {
+            // Update maximum of the current interval.
+            if (context->wind_gust_edge_sum > context->wind_gust_edge_sum_max_current) {
+                context->wind_gust_edge_sum_max_current = context->wind_gust_edge_sum;
+            }
+            // Hand the interval maximum over to the process function and start a new interval from the current sum.
+            request = context->wind_gust_request;
+            if (request != SEN15901_WIND_GUST_REQUEST_NONE) {
+                context->wind_gust_edge_sum_max_published = (request == SEN15901_WIND_GUST_REQUEST_PUBLISH) ? context->wind_gust_edge_sum_max_current : 0;
+                context->wind_gust_edge_sum_max_current = context->wind_gust_edge_sum;
+                // Published value is written before the request is acknowledged, a request changed in the meantime is kept for the next sample.
+#ifdef SEN15901_DRIVER_SMP
+                atomic_compare_exchange_strong(&(context->wind_gust_request), &request, SEN15901_WIND_GUST_REQUEST_NONE);
+#else
+                context->wind_gust_request = SEN15901_WIND_GUST_REQUEST_NONE;
+#endif
+            }
+        }
+    }
+}
+#endif
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_get_snapshot(SEN15901_measurements_t* measurements, SEN15901_snapshot_t* snapshot) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+    SEN15901_wind_direction_status_t sigma_status = SEN15901_WIND_DIRECTION_STATUS_UNDEFINED;
+#endif
+    // Compute outputs of the bank.
+    _SEN15901_get_wind_speed(measurements, &(snapshot->average_speed_mh), &(snapshot->peak_speed_mh));
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    _SEN15901_get_wind_gust(measurements, &(snapshot->gust_speed_mh));
+#endif
+#ifdef SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS
+    _SEN15901_copy_histogram(measurements->wind_speed_histogram, snapshot->wind_speed_histogram, SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS);
+#endif
+#ifdef SEN15901_DRIVER_WIND_ROSE
+    _SEN15901_copy_histogram(measurements->wind_rose, snapshot->wind_rose, SEN15901_WIND_ROSE_SECTORS_NUMBER);
+#endif
+    (snapshot->rainfall_um) = (int32_t) (measurements->rain_edge_count * SEN15901_RAIN_EDGE_TO_UM);
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+    status = _SEN15901_get_wind_direction_sigma(measurements, &(snapshot->direction_sigma_degrees), &sigma_status);
+    if (status != SEN15901_SUCCESS) goto errors;
+#endif
+    status = _SEN15901_get_wind_direction(measurements, &(snapshot->average_direction_degrees), &(snapshot->direction_status));
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+errors:
+#endif
+    return status;
+}
+
+/*** SEN15901 functions ***/
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_init(SEN15901_context_t* context, uint8_t hw_instance, SEN15901_process_cb_t process_callback) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_configuration_t hw_config;
+#if ((defined SEN15901_DRIVER_RAIN_RATE_RING_SIZE) || (defined SEN15901_DRIVER_AGGREGATION) || (defined SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION))
+    uint8_t idx = 0;
+#endif
+    // Check parameters.
+    if ((context == NULL) || (process_callback == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+    // Reset rings.
+    _SEN15901_edge_ring_reset(&(context->wind_speed_edge_ring));
+    _SEN15901_edge_ring_reset(&(context->rain_edge_ring));
+#endif
+#ifndef SEN15901_DRIVER_EDGE_RING_SIZE
+    context->wind_speed_edge_count = 0;
+    context->wind_speed_edge_count_read = 0;
+    context->rain_edge_count = 0;
+    context->rain_edge_count_read = 0;
+#endif
+#ifdef SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT
+    context->wind_speed_edge_last_valid = 0;
+    context->wind_speed_period_mh = 0;
+#endif
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    context->wind_gust_edge_sum_max_current = 0;
+    context->wind_gust_edge_sum_max_published = 0;
+    context->wind_gust_request = SEN15901_WIND_GUST_REQUEST_NONE;
+    context->wind_gust_edge_sum_max_closed = 0;
+    context->wind_gust_restart_flag = 0;
+    _SEN15901_wind_gust_restart(context);
+#endif
+#ifdef SEN15901_DRIVER_SMP
+    atomic_flag_clear(&(context->write_lock));
+    context->write_sequence = 0;
+#endif
+    // Reset banks.
+    _SEN15901_reset_measurements_bank(&(context->measurements_bank[0]));
+    _SEN15901_reset_measurements_bank(&(context->measurements_bank[1]));
+    context->measurements = &(context->measurements_bank[0]);
+    // Reset data.
+    SEN15901_instance_reset_measurements(context);
+    // Init context.
+    context->tick_second_flag = 0;
+    context->wind_measurement_enable_flag = 0;
+    context->process_callback = process_callback;
+    context->wind_speed_mh_last = 0;
+#ifdef SEN15901_DRIVER_TICKLESS
+    context->wakeup_delay_seconds = 0;
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+    context->wind_direction_adc_pending_flag = 0;
+    context->wind_direction_adc_done_flag = 0;
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING
+    context->wind_direction_rejected_count = 0;
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION
+    // Constant table until a calibration is applied or loaded.
+    for (idx = 0; idx < SEN15901_WIND_ROSE_SECTORS_NUMBER; idx++) {
+        context->wind_direction_calibration.plateau_permille[idx] = 0;
+    }
+    context->wind_direction_calibration_applied = context->wind_direction_calibration;
+    context->wind_direction_lut_valid_flag = 0;
+    context->wind_direction_learning_flag = 0;
+    context->wind_direction_calibration_store_callback = NULL;
+#endif
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+    _SEN15901_reset_instrumentation(context);
+#endif
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+    _SEN15901_reset_edge_guard(&(context->wind_speed_edge_guard), SEN15901_DRIVER_WIND_SPEED_DEBOUNCE_US);
+    _SEN15901_reset_edge_guard(&(context->rain_edge_guard), SEN15901_DRIVER_RAINFALL_DEBOUNCE_US);
+#endif
+#ifdef SEN15901_DRIVER_ADAPTIVE_SAMPLING
+    // Fixed periods until the policy is configured.
+    context->adaptive_sampling.wind_speed_period_min_seconds = SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS;
+    context->adaptive_sampling.wind_speed_period_max_seconds = SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS;
+    context->adaptive_sampling.wind_direction_period_min_seconds = SEN15901_DRIVER_WIND_DIRECTION_SAMPLING_PERIOD_SECONDS;
+    context->adaptive_sampling.wind_direction_period_max_seconds = SEN15901_DRIVER_WIND_DIRECTION_SAMPLING_PERIOD_SECONDS;
+    _SEN15901_reset_adaptive_sampling(&(context->adaptive_sampling));
+#endif
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+    context->rain_rate_clock_seconds = 0;
+    context->rain_tip_head = 0;
+    context->rain_tip_head_read = 0;
+    for (idx = 0; idx < SEN15901_RAIN_RATE_WINDOW_LAST; idx++) {
+        context->rain_tip_window_tail[idx] = 0;
+    }
+#ifdef SEN15901_DRIVER_TICKLESS
+    context->rain_rate_deadline_seconds = 0;
+    context->rain_rate_deadline_tip_head = 0;
+    context->rain_rate_deadline_flag = 0;
+#endif
+    context->rain_rate_alert_threshold_um_h = 0;
+    context->rain_rate_alert_callback = NULL;
+    context->rain_rate_alert_flag = 0;
+#endif
+#ifdef SEN15901_DRIVER_AGGREGATION
+    context->aggregation_clock_seconds = 0;
+    context->aggregation_clock_seconds_read = 0;
+    for (idx = 0; idx < SEN15901_AGGREGATION_LEVEL_LAST; idx++) {
+        _SEN15901_reset_measurements_bank(&(context->aggregation_current[idx]));
+        _SEN15901_reset_measurements_bank(&(context->aggregation_completed[idx]));
+    }
+    for (idx = 0; idx < (SEN15901_AGGREGATION_LEVEL_LAST - 1); idx++) {
+        context->aggregation_children_count[idx] = 0;
+    }
+#endif
+    // Init hardware interface.
+    hw_config.hw_instance = hw_instance;
+    hw_config.wind_speed_edge_irq_callback = &_SEN15901_wind_speed_edge_callback;
+    hw_config.rainfall_edge_irq_callback = &_SEN15901_rainfall_edge_callback;
+#ifdef SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT
+    hw_config.wind_speed_capture_irq_callback = &_SEN15901_wind_speed_capture_callback;
+#endif
+    hw_config.tick_second_irq_callback = &_SEN15901_tick_second_callback;
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    hw_config.tick_gust_irq_callback = &_SEN15901_tick_gust_callback;
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+    hw_config.adc_done_irq_callback = &_SEN15901_wind_direction_adc_done_callback;
+#endif
+    status = SEN15901_HW_init(context, &hw_config);
+    if (status != SEN15901_SUCCESS) goto errors;
+#if ((defined SEN15901_DRIVER_TICKLESS) && (defined SEN15901_DRIVER_AGGREGATION))
+    // Start the aggregation clock.
+    status = _SEN15901_set_wakeup_timer(context);
+    if (status != SEN15901_SUCCESS) goto errors;
+#endif
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_de_init(SEN15901_context_t* context) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameter.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Release hardware interface.
+    status = SEN15901_HW_de_init(context);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_set_wind_measurement(SEN15901_context_t* context, uint8_t enable) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameter.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    // Restart gust window before enabling sampling.
+    if ((enable != 0) && (context->wind_measurement_enable_flag == 0)) {
+        _SEN15901_wind_gust_restart(context);
+    }
+#endif
+    // Update local enable flag.
+    context->wind_measurement_enable_flag = enable;
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+    context->wind_speed_edge_guard.interrupt_enable_flag = enable;
+    context->wind_speed_edge_guard.masked_flag = 0;
+#endif
+    // Check enable bit.
+    if (enable == 0) {
+        // Reset second counters.
+        context->wind_speed_seconds_count = 0;
+        context->wind_direction_seconds_count = 0;
+        context->tick_second_flag = 0;
+#ifdef SEN15901_DRIVER_ADAPTIVE_SAMPLING
+        _SEN15901_reset_adaptive_sampling(&(context->adaptive_sampling));
+#endif
+    }
+    // Set interrupt state.
+    status = SEN15901_HW_set_wind_speed_interrupt(context, enable);
+    if (status != SEN15901_SUCCESS) goto errors;
+#ifdef SEN15901_DRIVER_TICKLESS
+    // Program first deadline or stop timer.
+    status = _SEN15901_set_wakeup_timer(context);
+    if (status != SEN15901_SUCCESS) goto errors;
+#endif
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_set_rainfall_measurement(SEN15901_context_t* context, uint8_t enable) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameter.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Set interrupt state.
+    status = SEN15901_HW_set_rainfall_interrupt(context, enable);
+    if (status != SEN15901_SUCCESS) goto errors;
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+    context->rain_edge_guard.interrupt_enable_flag = enable;
+    context->rain_edge_guard.masked_flag = 0;
+#endif
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_process(SEN15901_context_t* context) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_measurements_t* measurements = NULL;
+    uint32_t wind_speed_mh = 0;
+    uint8_t seconds_count = 0;
+    uint8_t window_seconds = 0;
+#if ((defined SEN15901_DRIVER_ADAPTIVE_SAMPLING) && (defined SEN15901_DRIVER_TICKLESS))
+    uint8_t wind_speed_period = 0;
+    uint8_t wind_direction_period = 0;
+#endif
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    uint32_t wind_gust_edge_sum_max = 0;
+#endif
+#ifndef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+    int32_t wind_direction_ratios_permille[SEN15901_WIND_DIRECTION_SAMPLES_NUMBER];
+#endif
+    // Check parameter.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    SEN15901_INSTRUMENTATION_PROCESS_START(context);
+    SEN15901_WRITE_BEGIN(context);
+#if ((defined SEN15901_DRIVER_ADAPTIVE_SAMPLING) && (defined SEN15901_DRIVER_TICKLESS))
+    wind_speed_period = context->adaptive_sampling.wind_speed_period_seconds;
+    wind_direction_period = context->adaptive_sampling.wind_direction_period_seconds;
+#endif
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+    // Complete wind direction update when the conversion result is available.
+    if (context->wind_direction_adc_done_flag != 0) {
+        context->wind_direction_adc_done_flag = 0;
+        context->wind_direction_adc_pending_flag = 0;
+        status = _SEN15901_add_wind_direction_sample(context, context->wind_direction_adc_ratio_permille, context->wind_direction_adc_wind_speed_mh);
+        if (status != SEN15901_SUCCESS) goto errors;
+    }
+#endif
+    // Check flag.
+    if (context->tick_second_flag == 0) goto errors;
+    // Clear flag.
+    context->tick_second_flag = 0;
+    // Update active bank.
+    measurements = context->measurements;
+    _SEN15901_update_rainfall(context);
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+    _SEN15901_update_rain_rate(context);
+#endif
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    // The interrupt only writes the published maximum while a request is pending: read it once acknowledged, then ask for the next one.
+    if (context->wind_gust_request == SEN15901_WIND_GUST_REQUEST_NONE) {
+        wind_gust_edge_sum_max = context->wind_gust_edge_sum_max_published;
+        context->wind_gust_request = SEN15901_WIND_GUST_REQUEST_PUBLISH;
+        _SEN15901_add_wind_gust(context, measurements, wind_gust_edge_sum_max);
+    }
+#endif
+    // Update wind speed if period is reached.
+    seconds_count = context->wind_speed_seconds_count;
+    if (seconds_count >= SEN15901_WIND_SPEED_SAMPLING_TIME_SECONDS(context)) {
+        // Reset seconds counter.
+        SEN15901_SHARED_CONSUME(context->wind_speed_seconds_count, seconds_count);
+#ifdef SEN15901_DRIVER_ADAPTIVE_SAMPLING
+        // The period may have changed since the previous sample.
+        window_seconds = seconds_count;
+#else
+        window_seconds = SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS;
+#endif
+        // Compute new value.
+        status = _SEN15901_compute_wind_speed(context, window_seconds, &wind_speed_mh);
+        if (status != SEN15901_SUCCESS) goto errors;
+#ifdef SEN15901_DRIVER_ADAPTIVE_SAMPLING
+        _SEN15901_adapt_wind_speed_sampling(context, wind_speed_mh);
+#endif
+        context->wind_speed_mh_last = wind_speed_mh;
+        // Update active bank.
+        _SEN15901_add_wind_speed(measurements, wind_speed_mh, window_seconds);
+#ifdef SEN15901_DRIVER_AGGREGATION
+        _SEN15901_add_wind_speed(&(context->aggregation_current[SEN15901_AGGREGATION_LEVEL_1_MINUTE]), wind_speed_mh, window_seconds);
+#endif
+    }
+    // Update wind direction if period is reached.
+    seconds_count = context->wind_direction_seconds_count;
+    if (seconds_count >= SEN15901_WIND_DIRECTION_SAMPLING_PERIOD_SECONDS(context)) {
+        // Reset seconds counter.
+        SEN15901_SHARED_CONSUME(context->wind_direction_seconds_count, seconds_count);
+        // Compute direction only if there is wind.
+        wind_speed_mh = context->wind_speed_mh_last;
+        if ((wind_speed_mh / 1000) > 0) {
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+            // Start conversion if the previous one is over, the direction is updated on completion.
+            if (context->wind_direction_adc_pending_flag == 0) {
+                context->wind_direction_adc_wind_speed_mh = wind_speed_mh;
+                context->wind_direction_adc_pending_flag = 1;
+                status = SEN15901_HW_adc_start_wind_direction_conversion(context, context->wind_direction_adc_ratio_permille, SEN15901_WIND_DIRECTION_SAMPLES_NUMBER);
+                if (status != SEN15901_SUCCESS) {
+                    context->wind_direction_adc_pending_flag = 0;
+                    goto errors;
+                }
+            }
+#else
+            // Turn external ADC on (readers are not held during the conversion).
+            SEN15901_WRITE_TOGGLE(context);
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING
+            status = SEN15901_HW_adc_get_wind_direction_ratios(context, wind_direction_ratios_permille, SEN15901_WIND_DIRECTION_SAMPLES_NUMBER);
+#else
+            status = SEN15901_HW_adc_get_wind_direction_ratio(context, &(wind_direction_ratios_permille[0]));
+#endif
+            SEN15901_WRITE_TOGGLE(context);
+            if (status != SEN15901_SUCCESS) goto errors;
+            // Convert ratios to direction and add new vector weighted by speed.
+            status = _SEN15901_add_wind_direction_sample(context, wind_direction_ratios_permille, wind_speed_mh);
+            if (status != SEN15901_SUCCESS) goto errors;
+#endif
+        }
+    }
+#ifdef SEN15901_DRIVER_AGGREGATION
+    // Close elapsed intervals once the samples of the current second are added.
+    _SEN15901_update_aggregation(context);
+#endif
+#if ((defined SEN15901_DRIVER_ADAPTIVE_SAMPLING) && (defined SEN15901_DRIVER_TICKLESS))
+    // Anticipate the next deadline when a period has been shortened.
+    if ((context->wind_measurement_enable_flag != 0) && (((context->adaptive_sampling.wind_speed_period_seconds) < wind_speed_period) || ((context->adaptive_sampling.wind_direction_period_seconds) < wind_direction_period))) {
+        status = _SEN15901_set_wakeup_timer(context);
+        if (status != SEN15901_SUCCESS) goto errors;
+    }
+#endif
+errors:
+    SEN15901_INSTRUMENTATION_PROCESS_END(context);
+    SEN15901_WRITE_END(context);
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_speed(SEN15901_context_t* context, int32_t* average_speed_mh, int32_t* peak_speed_mh) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (average_speed_mh == NULL) || (peak_speed_mh == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Read active bank.
+    SEN15901_READ_BEGIN(context);
+    _SEN15901_get_wind_speed(context->measurements, average_speed_mh, peak_speed_mh);
+    SEN15901_READ_END(context);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_direction(SEN15901_context_t* context, int32_t* average_direction_degrees, SEN15901_wind_direction_status_t* direction_status) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (average_direction_degrees == NULL) || (direction_status == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Read active bank.
+    SEN15901_READ_BEGIN(context);
+    status = _SEN15901_get_wind_direction(context->measurements, average_direction_degrees, direction_status);
+    SEN15901_READ_END(context);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_rainfall(SEN15901_context_t* context, int32_t* rainfall_um) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (rainfall_um == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Count pending edges without moving them, they are added to the active bank by the process function.
+    SEN15901_READ_BEGIN(context);
+    (*rainfall_um) = (int32_t) ((context->measurements->rain_edge_count + _SEN15901_get_rain_edge_count_pending(context)) * SEN15901_RAIN_EDGE_TO_UM);
+    SEN15901_READ_END(context);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_reset_measurements(SEN15901_context_t* context) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameter.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    SEN15901_WRITE_BEGIN(context);
+    // Wind speed.
+    context->wind_speed_seconds_count = 0;
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+    _SEN15901_edge_ring_drain(&(context->wind_speed_edge_ring), NULL, NULL);
+#ifdef SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT
+    context->wind_speed_edge_last_valid = 0;
+#endif
+#else
+    context->wind_speed_edge_count_read = context->wind_speed_edge_count;
+#endif
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    // Drop the maximum of the interval started before the reset.
+    context->wind_gust_request = SEN15901_WIND_GUST_REQUEST_DISCARD;
+#endif
+    // Wind direction.
+    context->wind_direction_seconds_count = 0;
+    // Rainfall.
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+    _SEN15901_edge_ring_drain(&(context->rain_edge_ring), NULL, NULL);
+#else
+    context->rain_edge_count_read = context->rain_edge_count;
+#endif
+    // Active bank.
+    _SEN15901_reset_measurements_bank(context->measurements);
+    SEN15901_WRITE_END(context);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_snapshot(SEN15901_context_t* context, SEN15901_snapshot_t* snapshot) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_measurements_t* measurements = NULL;
+    // Check parameters.
+    if ((context == NULL) || (snapshot == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    SEN15901_WRITE_BEGIN(context);
+    // Close current interval with the pending rainfall edges.
+    _SEN15901_update_rainfall(context);
+    measurements = context->measurements;
+    // Switch to the other bank, which has been cleared by the previous snapshot.
+    // Interrupts only update free running counters, so no critical section is required.
+    context->measurements = (measurements == &(context->measurements_bank[0])) ? &(context->measurements_bank[1]) : &(context->measurements_bank[0]);
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    // Close the gust interval, its maximum is only handed over to the process function at the next sample.
+    _SEN15901_close_wind_gust(context, measurements);
+#endif
+    // Compute outputs of the closed bank.
+    status = _SEN15901_get_snapshot(measurements, snapshot);
+    // Release closed bank.
+    _SEN15901_reset_measurements_bank(measurements);
+    SEN15901_WRITE_END(context);
+errors:
+    return status;
+}
+
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_gust(SEN15901_context_t* context, int32_t* gust_speed_mh) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (gust_speed_mh == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Read active bank.
+    SEN15901_READ_BEGIN(context);
+    _SEN15901_get_wind_gust(context->measurements, gust_speed_mh);
+    SEN15901_READ_END(context);
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_edge_ring_overflow(SEN15901_context_t* context, uint32_t* wind_speed_overflow_count, uint32_t* rainfall_overflow_count) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (wind_speed_overflow_count == NULL) || (rainfall_overflow_count == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*wind_speed_overflow_count) = context->wind_speed_edge_ring.overflow_count;
+    (*rainfall_overflow_count) = context->rain_edge_ring.overflow_count;
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_direction_rejected_count(SEN15901_context_t* context, uint32_t* rejected_count) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (rejected_count == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*rejected_count) = context->wind_direction_rejected_count;
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_ROSE
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_rose(SEN15901_context_t* context, uint16_t* wind_rose) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (wind_rose == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Read active bank.
+    SEN15901_READ_BEGIN(context);
+    _SEN15901_copy_histogram(context->measurements->wind_rose, wind_rose, SEN15901_WIND_ROSE_SECTORS_NUMBER);
+    SEN15901_READ_END(context);
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_speed_histogram(SEN15901_context_t* context, uint16_t* wind_speed_histogram) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (wind_speed_histogram == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Read active bank.
+    SEN15901_READ_BEGIN(context);
+    _SEN15901_copy_histogram(context->measurements->wind_speed_histogram, wind_speed_histogram, SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS);
+    SEN15901_READ_END(context);
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_rain_rate(SEN15901_context_t* context, SEN15901_rain_rate_window_t window, int32_t* rain_rate_um_h) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (rain_rate_um_h == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (window >= SEN15901_RAIN_RATE_WINDOW_LAST) {
+        status = SEN15901_ERROR_RAIN_RATE_WINDOW;
+        goto errors;
+    }
+    // Windows updated by the last process call.
+    SEN15901_READ_BEGIN(context);
+    (*rain_rate_um_h) = _SEN15901_get_rain_rate(context, window);
+    SEN15901_READ_END(context);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_set_rain_rate_alert(SEN15901_context_t* context, int32_t threshold_um_h, SEN15901_rain_rate_alert_cb_t alert_callback) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameter.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Update alert settings.
+    context->rain_rate_alert_threshold_um_h = threshold_um_h;
+    context->rain_rate_alert_callback = alert_callback;
+    context->rain_rate_alert_flag = 0;
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_AGGREGATION
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_aggregate(SEN15901_context_t* context, SEN15901_aggregation_level_t level, SEN15901_snapshot_t* snapshot) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (snapshot == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (level >= SEN15901_AGGREGATION_LEVEL_LAST) {
+        status = SEN15901_ERROR_AGGREGATION_LEVEL;
+        goto errors;
+    }
+    // Completed intervals are only replaced by the process function.
+    SEN15901_READ_BEGIN(context);
+    status = _SEN15901_get_snapshot(&(context->aggregation_completed[level]), snapshot);
+    SEN15901_READ_END(context);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_direction_sigma(SEN15901_context_t* context, int32_t* sigma_degrees, SEN15901_wind_direction_status_t* direction_status) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (sigma_degrees == NULL) || (direction_status == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Read active bank.
+    SEN15901_READ_BEGIN(context);
+    status = _SEN15901_get_wind_direction_sigma(context->measurements, sigma_degrees, direction_status);
+    SEN15901_READ_END(context);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_instrumentation(SEN15901_context_t* context, SEN15901_instrumentation_t* instrumentation) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (instrumentation == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Interrupts counters are read atomically.
+    instrumentation->wind_speed_edge_irq_count = context->instrumentation_wind_speed_edge_irq_count;
+    instrumentation->rainfall_edge_irq_count = context->instrumentation_rainfall_edge_irq_count;
+    instrumentation->tick_second_irq_count = context->instrumentation_tick_second_irq_count;
+    instrumentation->tick_gust_irq_count = context->instrumentation_tick_gust_irq_count;
+    instrumentation->adc_done_irq_count = context->instrumentation_adc_done_irq_count;
+    instrumentation->wind_speed_edge_rate_max = context->instrumentation_wind_speed_edge_rate_max;
+    instrumentation->rainfall_edge_rate_max = context->instrumentation_rainfall_edge_rate_max;
+    // Process statistics updated by the last process call.
+    SEN15901_READ_BEGIN(context);
+    instrumentation->process_call_count = context->instrumentation_process_call_count;
+    instrumentation->process_cycles_min = context->instrumentation_process_cycles_min;
+    instrumentation->process_cycles_max = context->instrumentation_process_cycles_max;
+    instrumentation->process_cycles_total = context->instrumentation_process_cycles_total;
+    SEN15901_READ_END(context);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_reset_instrumentation(SEN15901_context_t* context) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameter.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    SEN15901_WRITE_BEGIN(context);
+    _SEN15901_reset_instrumentation(context);
+    SEN15901_WRITE_END(context);
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_set_debounce(SEN15901_context_t* context, uint32_t wind_speed_debounce_us, uint32_t rainfall_debounce_us) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameter.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    _SEN15901_set_edge_guard_debounce(&(context->wind_speed_edge_guard), wind_speed_debounce_us);
+    _SEN15901_set_edge_guard_debounce(&(context->rain_edge_guard), rainfall_debounce_us);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_edge_guard_events(SEN15901_context_t* context, SEN15901_edge_guard_events_t* events) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (events == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    events->wind_speed_bounce_count = context->wind_speed_edge_guard.bounce_count;
+    events->wind_speed_storm_count = context->wind_speed_edge_guard.storm_count;
+    events->rainfall_bounce_count = context->rain_edge_guard.bounce_count;
+    events->rainfall_storm_count = context->rain_edge_guard.storm_count;
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_ADAPTIVE_SAMPLING
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_set_adaptive_sampling(SEN15901_context_t* context, uint8_t wind_speed_period_min_seconds, uint8_t wind_speed_period_max_seconds, uint8_t wind_direction_period_min_seconds, uint8_t wind_direction_period_max_seconds) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if ((wind_speed_period_min_seconds == 0) || (wind_speed_period_min_seconds > wind_speed_period_max_seconds) || (wind_direction_period_min_seconds == 0) || (wind_direction_period_min_seconds > wind_direction_period_max_seconds)) {
+        status = SEN15901_ERROR_SAMPLING_PERIOD;
+        goto errors;
+    }
+    SEN15901_WRITE_BEGIN(context);
+    context->adaptive_sampling.wind_speed_period_min_seconds = wind_speed_period_min_seconds;
+    context->adaptive_sampling.wind_speed_period_max_seconds = wind_speed_period_max_seconds;
+    context->adaptive_sampling.wind_direction_period_min_seconds = wind_direction_period_min_seconds;
+    context->adaptive_sampling.wind_direction_period_max_seconds = wind_direction_period_max_seconds;
+    _SEN15901_reset_adaptive_sampling(&(context->adaptive_sampling));
+    SEN15901_WRITE_END(context);
+#ifdef SEN15901_DRIVER_TICKLESS
+    // Apply the new periods to the current deadline.
+    if (context->wind_measurement_enable_flag != 0) {
+        status = _SEN15901_set_wakeup_timer(context);
+        if (status != SEN15901_SUCCESS) goto errors;
+    }
+#endif
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_sampling_periods(SEN15901_context_t* context, uint8_t* wind_speed_period_seconds, uint8_t* wind_direction_period_seconds) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (wind_speed_period_seconds == NULL) || (wind_direction_period_seconds == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*wind_speed_period_seconds) = context->adaptive_sampling.wind_speed_period_seconds;
+    (*wind_direction_period_seconds) = context->adaptive_sampling.wind_direction_period_seconds;
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_set_wind_direction_plateau(SEN15901_context_t* context, uint8_t sector, uint16_t plateau_permille) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if ((sector >= SEN15901_WIND_ROSE_SECTORS_NUMBER) || (plateau_permille > MATH_PERMILLE_MAX)) {
+        status = SEN15901_ERROR_WIND_DIRECTION_CALIBRATION;
+        goto errors;
+    }
+    context->wind_direction_calibration.plateau_permille[sector] = plateau_permille;
+errors:
+    return status;
+}
+
+#ifndef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_calibrate_wind_direction_sector(SEN15901_context_t* context, uint8_t sector) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    int32_t wind_direction_ratios_permille[SEN15901_WIND_DIRECTION_SAMPLES_NUMBER];
+    int32_t ratio_sum = 0;
+    int32_t ratio_count = 0;
+    uint8_t idx = 0;
+    // Check parameters.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (sector >= SEN15901_WIND_ROSE_SECTORS_NUMBER) {
+        status = SEN15901_ERROR_WIND_DIRECTION_CALIBRATION;
+        goto errors;
+    }
+    // Measure the current vane position.
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING
+    status = SEN15901_HW_adc_get_wind_direction_ratios(context, wind_direction_ratios_permille, SEN15901_WIND_DIRECTION_SAMPLES_NUMBER);
+#else
+    status = SEN15901_HW_adc_get_wind_direction_ratio(context, &(wind_direction_ratios_permille[0]));
+#endif
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Average valid ratios.
+    for (idx = 0; idx < SEN15901_WIND_DIRECTION_SAMPLES_NUMBER; idx++) {
+        if ((wind_direction_ratios_permille[idx] < 0) || (wind_direction_ratios_permille[idx] > MATH_PERMILLE_MAX)) continue;
+        ratio_sum += wind_direction_ratios_permille[idx];
+        ratio_count++;
+    }
+    if (ratio_count == 0) {
+        status = SEN15901_ERROR_RESISTOR_DIVIDER_RATIO;
+        goto errors;
+    }
+    status = SEN15901_instance_set_wind_direction_plateau(context, sector, (uint16_t) ((ratio_sum + (ratio_count >> 1)) / ratio_count));
+errors:
+    return status;
+}
+#endif
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_set_wind_direction_learning(SEN15901_context_t* context, uint8_t enable) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint8_t idx = 0;
+    // Check parameter.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    SEN15901_WRITE_BEGIN(context);
+    if (enable != 0) {
+        _SEN15901_reset_wind_direction_learning(context);
+    }
+    else if (context->wind_direction_learning_flag != 0) {
+        // Average ratio of each sector observed long enough.
+        for (idx = 0; idx < SEN15901_WIND_ROSE_SECTORS_NUMBER; idx++) {
+            if ((context->wind_direction_learning_count[idx]) < SEN15901_WIND_DIRECTION_LEARNING_SAMPLES_MIN) continue;
+            context->wind_direction_calibration.plateau_permille[idx] = (uint16_t) (((context->wind_direction_learning_sum[idx]) + ((context->wind_direction_learning_count[idx]) >> 1)) / (context->wind_direction_learning_count[idx]));
+        }
+    }
+    context->wind_direction_learning_flag = enable;
+    SEN15901_WRITE_END(context);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_apply_wind_direction_calibration(SEN15901_context_t* context) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameter.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    SEN15901_WRITE_BEGIN(context);
+    status = _SEN15901_build_wind_direction_lut(context, &(context->wind_direction_calibration));
+    if (status != SEN15901_SUCCESS) {
+        // Roll back the plateaus to the last applied calibration.
+        context->wind_direction_calibration = context->wind_direction_calibration_applied;
+    }
+    SEN15901_WRITE_END(context);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Save calibration.
+    if (context->wind_direction_calibration_store_callback != NULL) {
+        status = context->wind_direction_calibration_store_callback(&(context->wind_direction_calibration_applied));
+        if (status != SEN15901_SUCCESS) goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_set_wind_direction_calibration_callbacks(SEN15901_context_t* context, SEN15901_wind_direction_calibration_store_cb_t store_callback, SEN15901_wind_direction_calibration_load_cb_t load_callback) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_wind_direction_calibration_t calibration;
+    // Check parameter.
+    if (context == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    context->wind_direction_calibration_store_callback = store_callback;
+    if (load_callback == NULL) goto errors;
+    // Restore saved plateaus, the current calibration is kept if they are not valid.
+    status = load_callback(&calibration);
+    if (status != SEN15901_SUCCESS) goto errors;
+    SEN15901_WRITE_BEGIN(context);
+    status = _SEN15901_build_wind_direction_lut(context, &calibration);
+    SEN15901_WRITE_END(context);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_instance_get_wind_direction_calibration(SEN15901_context_t* context, SEN15901_wind_direction_calibration_t* calibration) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((context == NULL) || (calibration == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*calibration) = context->wind_direction_calibration;
+errors:
+    return status;
+}
+#endif
+
+#ifndef SEN15901_DRIVER_SINGLETON_API_DISABLE
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_init(SEN15901_singleton_process_cb_t process_callback) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameter.
+    if (process_callback == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Init default instance.
+    sen15901_process_callback = process_callback;
+    status = SEN15901_instance_init(&sen15901_ctx, 0, &_SEN15901_process_callback);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_de_init(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_de_init(&sen15901_ctx);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_set_wind_measurement(uint8_t enable) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_set_wind_measurement(&sen15901_ctx, enable);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
 
-/*** SEN15901 local macros ***/
+/*******************************************************************/
+SEN15901_status_t SEN15901_set_rainfall_measurement(uint8_t enable) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_set_rainfall_measurement(&sen15901_ctx, enable);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
 
-#define SEN15901_WIND_SPEED_1HZ_TO_MH                           2400
-#define SEN15901_WIND_DIRECTIONS_NUMBER                         16
+/*******************************************************************/
+SEN15901_status_t SEN15901_process(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_process(&sen15901_ctx);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
 
-#define SEN15901_RAIN_EDGE_TO_UM                                279
+/*******************************************************************/
+SEN15901_status_t SEN15901_get_wind_speed(int32_t* average_speed_mh, int32_t* peak_speed_mh) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_get_wind_speed(&sen15901_ctx, average_speed_mh, peak_speed_mh);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
 
-#define SEN15901_RESISTOR_DIVIDER_RATIO(rw)                     ((MATH_PERMILLE_MAX * rw) / (rw + SEN15901_DRIVER_WIND_DIRECTION_PULL_UP_RESISTOR_OHMS))
-#define SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(rw1, rw2)     ((SEN15901_RESISTOR_DIVIDER_RATIO(rw1) + SEN15901_RESISTOR_DIVIDER_RATIO(rw2)) >> 1)
+/*******************************************************************/
+SEN15901_status_t SEN15901_get_wind_direction(int32_t* average_direction_degrees, SEN15901_wind_direction_status_t* direction_status) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_get_wind_direction(&sen15901_ctx, average_direction_degrees, direction_status);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
 
-/*** SEN15901 local structures ***/
+/*******************************************************************/
+SEN15901_status_t SEN15901_get_rainfall(int32_t* rainfall_um) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_get_rainfall(&sen15901_ctx, rainfall_um);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
 
 /*******************************************************************/
-typedef struct {
-    // State machine.
-    SEN15901_process_cb_t process_callback;
-    volatile uint8_t tick_second_flag;
-    uint8_t wind_measurement_enable_flag;
-    // Wind speed.
-    volatile uint8_t wind_speed_seconds_count;
-    volatile uint32_t wind_speed_edge_count;
-    uint32_t wind_speed_data_count;
-    uint32_t wind_speed_mh_average;
-    uint32_t wind_speed_mh_peak;
-    // Wind direction.
-    volatile uint8_t wind_direction_seconds_count;
-    int32_t wind_direction_trend_point_x;
-    int32_t wind_direction_trend_point_y;
-    // Rainfall.
-    volatile uint32_t rain_edge_count;
-} SEN15901_context_t;
+void SEN15901_reset_measurements(void) {
+    SEN15901_instance_reset_measurements(&sen15901_ctx);
+}
 
-/*** SEN15901 local global variables ***/
+/*******************************************************************/
+SEN15901_status_t SEN15901_snapshot(SEN15901_snapshot_t* snapshot) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_snapshot(&sen15901_ctx, snapshot);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
 
-static const int32_t SEN15901_WIND_DIRECTION_RATIO_THRESHOLD[SEN15901_WIND_DIRECTIONS_NUMBER] = {
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(688,   891),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(891,   1000),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(1000,  1410),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(1410,  2200),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(2200,  3140),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(3140,  3900),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(3900,  6570),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(6570,  8200),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(8200,  14120),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(14120, 16000),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(16000, 21880),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(21880, 33000),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(33000, 42120),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(42120, 64900),
-    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(64900, 120000),
-    MATH_PERMILLE_MAX
-};
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+/*******************************************************************/
+SEN15901_status_t SEN15901_get_wind_gust(int32_t* gust_speed_mh) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_get_wind_gust(&sen15901_ctx, gust_speed_mh);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+#endif
 
-static const uint32_t SEN15901_WIND_DIRECTION_ANGLE_DEGREES[SEN15901_WIND_DIRECTIONS_NUMBER] = { 112, 67, 90, 157, 135, 202, 180, 22, 45, 247, 225, 337, 0, 292, 315, 270 };
+#ifdef SEN15901_DRIVER_EDGE_RING_SIZE
+/*******************************************************************/
+SEN15901_status_t SEN15901_get_edge_ring_overflow(uint32_t* wind_speed_overflow_count, uint32_t* rainfall_overflow_count) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_get_edge_ring_overflow(&sen15901_ctx, wind_speed_overflow_count, rainfall_overflow_count);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+#endif
 
-static SEN15901_context_t sen15901_ctx;
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING
+/*******************************************************************/
+SEN15901_status_t SEN15901_get_wind_direction_rejected_count(uint32_t* rejected_count) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_get_wind_direction_rejected_count(&sen15901_ctx, rejected_count);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+#endif
 
-/*** SEN15901 local functions ***/
+#ifdef SEN15901_DRIVER_WIND_ROSE
+/*******************************************************************/
+SEN15901_status_t SEN15901_get_wind_rose(uint16_t* wind_rose) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_get_wind_rose(&sen15901_ctx, wind_rose);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+#endif
 
+#ifdef SEN15901_DRIVER_WIND_SPEED_HISTOGRAM_BINS
 /*******************************************************************/
-static void _SEN15901_wind_speed_edge_callback(void) {
-    // Wind speed.
-    sen15901_ctx.wind_speed_edge_count++;
+SEN15901_status_t SEN15901_get_wind_speed_histogram(uint16_t* wind_speed_histogram) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_get_wind_speed_histogram(&sen15901_ctx, wind_speed_histogram);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
 }
+#endif
 
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
 /*******************************************************************/
-static void _SEN15901_rainfall_edge_callback(void) {
-    // Increment edge count.
-    sen15901_ctx.rain_edge_count++;
+SEN15901_status_t SEN15901_get_rain_rate(SEN15901_rain_rate_window_t window, int32_t* rain_rate_um_h) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_get_rain_rate(&sen15901_ctx, window, rain_rate_um_h);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
 }
 
 /*******************************************************************/
-static void _SEN15901_tick_second_callback(void) {
-    // Check enable flag.
-    if (sen15901_ctx.wind_measurement_enable_flag != 0) {
-        // Update local flags.
-        sen15901_ctx.wind_speed_seconds_count++;
-        sen15901_ctx.wind_direction_seconds_count++;
-        sen15901_ctx.tick_second_flag = 1;
-        // Ask for processing.
-        if (sen15901_ctx.process_callback != NULL) {
-            sen15901_ctx.process_callback();
-        }
-    }
+SEN15901_status_t SEN15901_set_rain_rate_alert(int32_t threshold_um_h, SEN15901_rain_rate_alert_cb_t alert_callback) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_set_rain_rate_alert(&sen15901_ctx, threshold_um_h, alert_callback);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_AGGREGATION
+/*******************************************************************/
+SEN15901_status_t SEN15901_get_aggregate(SEN15901_aggregation_level_t level, SEN15901_snapshot_t* snapshot) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_get_aggregate(&sen15901_ctx, level, snapshot);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
 }
+#endif
 
-/*** SEN15901 functions ***/
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_VARIABILITY
+/*******************************************************************/
+SEN15901_status_t SEN15901_get_wind_direction_sigma(int32_t* sigma_degrees, SEN15901_wind_direction_status_t* direction_status) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_get_wind_direction_sigma(&sen15901_ctx, sigma_degrees, direction_status);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+#endif
 
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
 /*******************************************************************/
-SEN15901_status_t SEN15901_init(SEN15901_process_cb_t process_callback) {
+SEN15901_status_t SEN15901_get_instrumentation(SEN15901_instrumentation_t* instrumentation) {
     // Local variables.
     SEN15901_status_t status = SEN15901_SUCCESS;
-    SEN15901_HW_configuration_t hw_config;
-    // Reset data.
-    SEN15901_reset_measurements();
-    // Check parameter.
-    if (process_callback == NULL) {
-        status = SEN15901_ERROR_NULL_PARAMETER;
-        goto errors;
-    }
-    // Init context.
-    sen15901_ctx.wind_measurement_enable_flag = 0;
-    sen15901_ctx.process_callback = process_callback;
-    // Init hardware interface.
-    hw_config.wind_speed_edge_irq_callback = &_SEN15901_wind_speed_edge_callback;
-    hw_config.rainfall_edge_irq_callback = &_SEN15901_rainfall_edge_callback;
-    hw_config.tick_second_irq_callback = &_SEN15901_tick_second_callback;
-    status = SEN15901_HW_init(&hw_config);
+    status = SEN15901_instance_get_instrumentation(&sen15901_ctx, instrumentation);
     if (status != SEN15901_SUCCESS) goto errors;
 errors:
     return status;
 }
 
 /*******************************************************************/
-SEN15901_status_t SEN15901_de_init(void) {
+SEN15901_status_t SEN15901_reset_instrumentation(void) {
     // Local variables.
     SEN15901_status_t status = SEN15901_SUCCESS;
-    // Release hardware interface.
-    status = SEN15901_HW_de_init();
+    status = SEN15901_instance_reset_instrumentation(&sen15901_ctx);
     if (status != SEN15901_SUCCESS) goto errors;
 errors:
     return status;
 }
+#endif
 
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
 /*******************************************************************/
-SEN15901_status_t SEN15901_set_wind_measurement(uint8_t enable) {
+SEN15901_status_t SEN15901_set_debounce(uint32_t wind_speed_debounce_us, uint32_t rainfall_debounce_us) {
     // Local variables.
     SEN15901_status_t status = SEN15901_SUCCESS;
-    // Update local enable flag.
-    sen15901_ctx.wind_measurement_enable_flag = enable;
-    // Check enable bit.
-    if (enable == 0) {
-        // Reset second counters.
-        sen15901_ctx.wind_speed_seconds_count = 0;
-        sen15901_ctx.wind_direction_seconds_count = 0;
-        sen15901_ctx.tick_second_flag = 0;
-    }
-    // Set interrupt state.
-    status = SEN15901_HW_set_wind_speed_interrupt(enable);
+    status = SEN15901_instance_set_debounce(&sen15901_ctx, wind_speed_debounce_us, rainfall_debounce_us);
     if (status != SEN15901_SUCCESS) goto errors;
 errors:
     return status;
 }
 
 /*******************************************************************/
-SEN15901_status_t SEN15901_set_rainfall_measurement(uint8_t enable) {
+SEN15901_status_t SEN15901_get_edge_guard_events(SEN15901_edge_guard_events_t* events) {
     // Local variables.
     SEN15901_status_t status = SEN15901_SUCCESS;
-    // Set interrupt state.
-    status = SEN15901_HW_set_rainfall_interrupt(enable);
+    status = SEN15901_instance_get_edge_guard_events(&sen15901_ctx, events);
     if (status != SEN15901_SUCCESS) goto errors;
 errors:
     return status;
 }
+#endif
 
+#ifdef SEN15901_DRIVER_ADAPTIVE_SAMPLING
 /*******************************************************************/
-SEN15901_status_t SEN15901_process(void) {
+SEN15901_status_t SEN15901_set_adaptive_sampling(uint8_t wind_speed_period_min_seconds, uint8_t wind_speed_period_max_seconds, uint8_t wind_direction_period_min_seconds, uint8_t wind_direction_period_max_seconds) {
     // Local variables.
     SEN15901_status_t status = SEN15901_SUCCESS;
-    uint32_t wind_speed_mh = 0;
-    uint32_t wind_direction_degrees = 0;
-    int32_t wind_direction_ratio_permille = 0;
-    uint8_t ratio_valid = 0;
-    uint8_t idx = 0;
-    // Check flag.
-    if (sen15901_ctx.tick_second_flag == 0) goto errors;
-    // Clear flag.
-    sen15901_ctx.tick_second_flag = 0;
-    // Update wind speed if period is reached.
-    if (sen15901_ctx.wind_speed_seconds_count >= SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS) {
-        // Reset seconds counter.
-        sen15901_ctx.wind_speed_seconds_count = 0;
-        // Compute new value.
-        wind_speed_mh = (sen15901_ctx.wind_speed_edge_count * SEN15901_WIND_SPEED_1HZ_TO_MH) / (SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS);
-        sen15901_ctx.wind_speed_edge_count = 0;
-        // Update peak value if required.
-        if (wind_speed_mh > sen15901_ctx.wind_speed_mh_peak) {
-            sen15901_ctx.wind_speed_mh_peak = wind_speed_mh;
-        }
-        // Update average value.
-        MATH_rolling_mean(sen15901_ctx.wind_speed_mh_average, sen15901_ctx.wind_speed_data_count, wind_speed_mh, uint32_t);
-    }
-    // Update wind direction if period is reached.
-    if (sen15901_ctx.wind_direction_seconds_count >= SEN15901_DRIVER_WIND_DIRECTION_SAMPLING_PERIOD_SECONDS) {
-        // Reset seconds counter.
-        sen15901_ctx.wind_direction_seconds_count = 0;
-        // Compute direction only if there is wind.
-        if ((wind_speed_mh / 1000) > 0) {
-            // Turn external ADC on.
-            status = SEN15901_HW_adc_get_wind_direction_ratio(&wind_direction_ratio_permille);
-            if (status != SEN15901_SUCCESS) goto errors;
-            // Convert ratio to direction.
-            for (idx = 0; idx < SEN15901_WIND_DIRECTIONS_NUMBER; idx++) {
-                if (wind_direction_ratio_permille <= SEN15901_WIND_DIRECTION_RATIO_THRESHOLD[idx]) {
-                    // Update current angle and table index.
-                    wind_direction_degrees = SEN15901_WIND_DIRECTION_ANGLE_DEGREES[idx];
-                    ratio_valid = 1;
-                    break;
-                }
-            }
-            if (ratio_valid == 0) {
-                status = SEN15901_ERROR_RESISTOR_DIVIDER_RATIO;
-                goto errors;
-            }
-            // Add new vector weighted by speed.
-            sen15901_ctx.wind_direction_trend_point_x += ((int32_t) (wind_speed_mh / 1000)) * ((int32_t) MATH_COS_TABLE[wind_direction_degrees]);
-            sen15901_ctx.wind_direction_trend_point_y += ((int32_t) (wind_speed_mh / 1000)) * ((int32_t) MATH_SIN_TABLE[wind_direction_degrees]);
-        }
-    }
+    status = SEN15901_instance_set_adaptive_sampling(&sen15901_ctx, wind_speed_period_min_seconds, wind_speed_period_max_seconds, wind_direction_period_min_seconds, wind_direction_period_max_seconds);
+    if (status != SEN15901_SUCCESS) goto errors;
 errors:
     return status;
 }
 
 /*******************************************************************/
-SEN15901_status_t SEN15901_get_wind_speed(int32_t* average_speed_mh, int32_t* peak_speed_mh) {
+SEN15901_status_t SEN15901_get_sampling_periods(uint8_t* wind_speed_period_seconds, uint8_t* wind_direction_period_seconds) {
     // Local variables.
     SEN15901_status_t status = SEN15901_SUCCESS;
-    // Check parameters.
-    if ((average_speed_mh == NULL) || (peak_speed_mh == NULL)) {
-        status = SEN15901_ERROR_NULL_PARAMETER;
-        goto errors;
-    }
-    (*average_speed_mh) = (int32_t) (sen15901_ctx.wind_speed_mh_average);
-    (*peak_speed_mh) = (int32_t) (sen15901_ctx.wind_speed_mh_peak);
+    status = SEN15901_instance_get_sampling_periods(&sen15901_ctx, wind_speed_period_seconds, wind_direction_period_seconds);
+    if (status != SEN15901_SUCCESS) goto errors;
 errors:
     return status;
 }
+#endif
 
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_CALIBRATION
 /*******************************************************************/
-SEN15901_status_t SEN15901_get_wind_direction(int32_t* average_direction_degrees, SEN15901_wind_direction_status_t* direction_status) {
+SEN15901_status_t SEN15901_set_wind_direction_plateau(uint8_t sector, uint16_t plateau_permille) {
     // Local variables.
     SEN15901_status_t status = SEN15901_SUCCESS;
-    MATH_status_t math_status = MATH_SUCCESS;
-    // Check parameters.
-    if ((average_direction_degrees == NULL) || (direction_status == NULL)) {
-        status = SEN15901_ERROR_NULL_PARAMETER;
-        goto errors;
-    }
-    // Reset output status.
-    (*direction_status) = SEN15901_WIND_DIRECTION_STATUS_UNDEFINED;
-    // Check trend point coordinates.
-    if ((sen15901_ctx.wind_direction_trend_point_x != 0) || (sen15901_ctx.wind_direction_trend_point_y != 0)) {
-        // Compute trend point angle.
-        math_status = MATH_atan2(sen15901_ctx.wind_direction_trend_point_x, sen15901_ctx.wind_direction_trend_point_y, average_direction_degrees);
-        MATH_exit_error(SEN15901_ERROR_BASE_MATH);
-        // Update output status.
-        (*direction_status) = SEN15901_WIND_DIRECTION_STATUS_AVAILABLE;
-    }
+    status = SEN15901_instance_set_wind_direction_plateau(&sen15901_ctx, sector, plateau_permille);
+    if (status != SEN15901_SUCCESS) goto errors;
 errors:
     return status;
 }
 
+#ifndef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
 /*******************************************************************/
-SEN15901_status_t SEN15901_get_rainfall(int32_t* rainfall_um) {
+SEN15901_status_t SEN15901_calibrate_wind_direction_sector(uint8_t sector) {
     // Local variables.
     SEN15901_status_t status = SEN15901_SUCCESS;
-    // Check parameter.
-    if (rainfall_um == NULL) {
-        status = SEN15901_ERROR_NULL_PARAMETER;
-        goto errors;
-    }
-    // Convert edge count to mm of rain.
-    (*rainfall_um) = (int32_t) (sen15901_ctx.rain_edge_count * SEN15901_RAIN_EDGE_TO_UM);
+    status = SEN15901_instance_calibrate_wind_direction_sector(&sen15901_ctx, sector);
+    if (status != SEN15901_SUCCESS) goto errors;
 errors:
     return status;
 }
+#endif
 
 /*******************************************************************/
-void SEN15901_reset_measurements(void) {
-    // Wind speed.
-    sen15901_ctx.wind_speed_seconds_count = 0;
-    sen15901_ctx.wind_speed_edge_count = 0;
-    sen15901_ctx.wind_speed_data_count = 0;
-    sen15901_ctx.wind_speed_mh_average = 0;
-    sen15901_ctx.wind_speed_mh_peak = 0;
-    // Wind direction.
-    sen15901_ctx.wind_direction_seconds_count = 0;
-    sen15901_ctx.wind_direction_trend_point_x = 0;
-    sen15901_ctx.wind_direction_trend_point_y = 0;
-    // Rainfall.
-    sen15901_ctx.rain_edge_count = 0;
+SEN15901_status_t SEN15901_set_wind_direction_learning(uint8_t enable) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_set_wind_direction_learning(&sen15901_ctx, enable);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_apply_wind_direction_calibration(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_apply_wind_direction_calibration(&sen15901_ctx);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_set_wind_direction_calibration_callbacks(SEN15901_wind_direction_calibration_store_cb_t store_callback, SEN15901_wind_direction_calibration_load_cb_t load_callback) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_set_wind_direction_calibration_callbacks(&sen15901_ctx, store_callback, load_callback);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_get_wind_direction_calibration(SEN15901_wind_direction_calibration_t* calibration) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    status = SEN15901_instance_get_wind_direction_calibration(&sen15901_ctx, calibration);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
 }
+#endif
+
+#endif /* SEN15901_DRIVER_SINGLETON_API_DISABLE */
 
 #endif /* SEN15901_DRIVER_DISABLE */
@@ -0,0 +1,424 @@
+/*
+ * sen15901_bulk.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "sen15901_bulk.h"
+
+#ifndef SEN15901_DRIVER_DISABLE_FLAGS_FILE
+#include "sen15901_driver_flags.h"
+#endif
+#include "error.h"
+#include "maths.h"
+#include "sen15901.h"
+#include "sen15901_tables.h"
+#include "types.h"
+#if (defined __AVX2__)
+#include <immintrin.h>
+#elif (defined __SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if (!(defined SEN15901_DRIVER_DISABLE) && (defined SEN15901_DRIVER_BULK))
+
+/*** SEN15901 BULK local macros ***/
+
+#if (SEN15901_BULK_WIND_DIRECTIONS_NUMBER != SEN15901_WIND_DIRECTIONS_NUMBER)
+#error "SEN15901 driver: SEN15901_BULK_WIND_DIRECTIONS_NUMBER does not match the wind direction tables"
+#endif
+
+// Number of samples processed by each vector instruction.
+#if (defined __AVX2__)
+#define SEN15901_BULK_SIMD_WIDTH                8
+#elif (defined __SSE2__)
+#define SEN15901_BULK_SIMD_WIDTH                4
+#else
+#define SEN15901_BULK_SIMD_WIDTH                1
+#endif
+
+// Number of samples of the trend blocks, whose rescaling is checked once.
+#define SEN15901_BULK_BLOCK_SIZE                (8 * SEN15901_BULK_SIMD_WIDTH)
+
+#define SEN15901_BULK_WIND_DIRECTION_INDEX_NULL SEN15901_WIND_DIRECTIONS_NUMBER
+
+/*** SEN15901 BULK local functions ***/
+
+/*******************************************************************/
+static uint8_t _SEN15901_BULK_get_wind_direction_index(int32_t wind_direction_ratio_permille) {
+    // Local variables.
+    uint8_t wind_direction_index = 0;
+    uint8_t idx = 0;
+    // Check ratio range.
+    if (wind_direction_ratio_permille > MATH_PERMILLE_MAX) {
+        return SEN15901_BULK_WIND_DIRECTION_INDEX_ERROR;
+    }
+    // Count sorted thresholds below the ratio, which gives the same index as the driver binary search.
+    for (idx = 0; idx < (SEN15901_WIND_DIRECTIONS_NUMBER - 1); idx++) {
+        wind_direction_index += (wind_direction_ratio_permille > SEN15901_WIND_DIRECTION_RATIO_THRESHOLD[idx]) ? 1 : 0;
+    }
+    return wind_direction_index;
+}
+
+/*******************************************************************/
+static int32_t _SEN15901_BULK_get_vector(int32_t wind_speed_kmh, int32_t unit) {
+    // Same 32-bit product as the driver, wrapped instead of undefined on overflow.
+    return (int32_t) (((uint32_t) wind_speed_kmh) * ((uint32_t) unit));
+}
+
+/*******************************************************************/
+static void _SEN15901_BULK_add_vector(SEN15901_BULK_trend_t* trend, int32_t vector_x, int32_t vector_y) {
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    // Add new vector.
+    trend->trend_point_x += (int64_t) vector_x;
+    trend->trend_point_y += (int64_t) vector_y;
+#else
+    // Add new vector with the current scale.
+    trend->trend_point_x += (vector_x >> (trend->trend_point_shift));
+    trend->trend_point_y += (vector_y >> (trend->trend_point_shift));
+    // Halve trend point and future vectors before reaching overflow.
+    if ((trend->trend_point_x > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (trend->trend_point_x < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT)) ||
+        (trend->trend_point_y > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (trend->trend_point_y < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT))) {
+        trend->trend_point_x >>= 1;
+        trend->trend_point_y >>= 1;
+        trend->trend_point_shift++;
+    }
+#endif
+}
+
+#if (SEN15901_BULK_SIMD_WIDTH > 1)
+#if (defined __AVX2__)
+typedef __m256i SEN15901_BULK_vector_t;
+#define SEN15901_BULK_load(pointer)                 _mm256_loadu_si256((const __m256i*) (pointer))
+#define SEN15901_BULK_store(pointer, vector)        _mm256_storeu_si256((__m256i*) (pointer), vector)
+#define SEN15901_BULK_set1(value)                   _mm256_set1_epi32(value)
+#define SEN15901_BULK_zero()                        _mm256_setzero_si256()
+#define SEN15901_BULK_sub_epi32(a, b)               _mm256_sub_epi32(a, b)
+#define SEN15901_BULK_add_epi64(a, b)               _mm256_add_epi64(a, b)
+#define SEN15901_BULK_xor(a, b)                     _mm256_xor_si256(a, b)
+#define SEN15901_BULK_and(a, b)                     _mm256_and_si256(a, b)
+#define SEN15901_BULK_or(a, b)                      _mm256_or_si256(a, b)
+#define SEN15901_BULK_cmpgt_epi32(a, b)             _mm256_cmpgt_epi32(a, b)
+#define SEN15901_BULK_srai_epi32(a, count)          _mm256_srai_epi32(a, count)
+#define SEN15901_BULK_sra_epi32(a, count)           _mm256_sra_epi32(a, _mm_cvtsi32_si128(count))
+#define SEN15901_BULK_unpacklo_epi32(a, b)          _mm256_unpacklo_epi32(a, b)
+#define SEN15901_BULK_unpackhi_epi32(a, b)          _mm256_unpackhi_epi32(a, b)
+#define SEN15901_BULK_mullo_epi32(a, b)             _mm256_mullo_epi32(a, b)
+#define SEN15901_BULK_movemask(a)                   _mm256_movemask_epi8(a)
+#else
+typedef __m128i SEN15901_BULK_vector_t;
+#define SEN15901_BULK_load(pointer)                 _mm_loadu_si128((const __m128i*) (pointer))
+#define SEN15901_BULK_store(pointer, vector)        _mm_storeu_si128((__m128i*) (pointer), vector)
+#define SEN15901_BULK_set1(value)                   _mm_set1_epi32(value)
+#define SEN15901_BULK_zero()                        _mm_setzero_si128()
+#define SEN15901_BULK_sub_epi32(a, b)               _mm_sub_epi32(a, b)
+#define SEN15901_BULK_add_epi64(a, b)               _mm_add_epi64(a, b)
+#define SEN15901_BULK_xor(a, b)                     _mm_xor_si128(a, b)
+#define SEN15901_BULK_and(a, b)                     _mm_and_si128(a, b)
+#define SEN15901_BULK_or(a, b)                      _mm_or_si128(a, b)
+#define SEN15901_BULK_cmpgt_epi32(a, b)             _mm_cmpgt_epi32(a, b)
+#define SEN15901_BULK_srai_epi32(a, count)          _mm_srai_epi32(a, count)
+#define SEN15901_BULK_sra_epi32(a, count)           _mm_sra_epi32(a, _mm_cvtsi32_si128(count))
+#define SEN15901_BULK_unpacklo_epi32(a, b)          _mm_unpacklo_epi32(a, b)
+#define SEN15901_BULK_unpackhi_epi32(a, b)          _mm_unpackhi_epi32(a, b)
+#define SEN15901_BULK_mullo_epi32(a, b)             _SEN15901_BULK_mullo_epi32(a, b)
+#define SEN15901_BULK_movemask(a)                   _mm_movemask_epi8(a)
+
+/*******************************************************************/
+static __m128i _SEN15901_BULK_mullo_epi32(__m128i a, __m128i b) {
+    // SSE2 has no 32-bit low product: multiply even and odd lanes separately and interleave the low halves.
+    __m128i product_even = _mm_mul_epu32(a, b);
+    __m128i product_odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(product_even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(product_odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+#endif
+
+/*******************************************************************/
+static int64_t _SEN15901_BULK_sum_epi64(SEN15901_BULK_vector_t sum) {
+    // Local variables.
+    int64_t lanes[SEN15901_BULK_SIMD_WIDTH / 2];
+    int64_t result = 0;
+    uint8_t idx = 0;
+    // Horizontal sum.
+    SEN15901_BULK_store(lanes, sum);
+    for (idx = 0; idx < (SEN15901_BULK_SIMD_WIDTH / 2); idx++) {
+        result += lanes[idx];
+    }
+    return result;
+}
+
+/*******************************************************************/
+static void _SEN15901_BULK_get_wind_direction_indexes(const int32_t* wind_direction_ratio_permille, int32_t* wind_direction_index, uint8_t* error_flag) {
+    // Local variables.
+    SEN15901_BULK_vector_t ratio = SEN15901_BULK_load(wind_direction_ratio_permille);
+    SEN15901_BULK_vector_t index = SEN15901_BULK_zero();
+    SEN15901_BULK_vector_t error = SEN15901_BULK_cmpgt_epi32(ratio, SEN15901_BULK_set1(MATH_PERMILLE_MAX));
+    uint8_t idx = 0;
+    // Each comparison mask is -1 when the ratio is above the threshold.
+    for (idx = 0; idx < (SEN15901_WIND_DIRECTIONS_NUMBER - 1); idx++) {
+        index = SEN15901_BULK_sub_epi32(index, SEN15901_BULK_cmpgt_epi32(ratio, SEN15901_BULK_set1(SEN15901_WIND_DIRECTION_RATIO_THRESHOLD[idx])));
+    }
+    // Out of range lanes are set to 0xFF (index is at most 15).
+    index = SEN15901_BULK_or(index, SEN15901_BULK_and(error, SEN15901_BULK_set1(SEN15901_BULK_WIND_DIRECTION_INDEX_ERROR)));
+    SEN15901_BULK_store(wind_direction_index, index);
+    (*error_flag) = (SEN15901_BULK_movemask(error) != 0) ? 1 : 0;
+}
+
+/*******************************************************************/
+static void _SEN15901_BULK_sum_vectors(SEN15901_BULK_vector_t vector, SEN15901_BULK_vector_t* sum, SEN15901_BULK_vector_t* magnitude_sum) {
+    // Local variables.
+    SEN15901_BULK_vector_t sign = SEN15901_BULK_srai_epi32(vector, 31);
+#ifndef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    // Unsigned absolute values, zero extended to 64 bits.
+    SEN15901_BULK_vector_t magnitude = SEN15901_BULK_sub_epi32(SEN15901_BULK_xor(vector, sign), sign);
+    (*magnitude_sum) = SEN15901_BULK_add_epi64((*magnitude_sum), SEN15901_BULK_add_epi64(SEN15901_BULK_unpacklo_epi32(magnitude, SEN15901_BULK_zero()), SEN15901_BULK_unpackhi_epi32(magnitude, SEN15901_BULK_zero())));
+#else
+    UNUSED(magnitude_sum);
+#endif
+    // Sign extended to 64 bits.
+    (*sum) = SEN15901_BULK_add_epi64((*sum), SEN15901_BULK_add_epi64(SEN15901_BULK_unpacklo_epi32(vector, sign), SEN15901_BULK_unpackhi_epi32(vector, sign)));
+}
+
+/*******************************************************************/
+static void _SEN15901_BULK_add_vectors(SEN15901_BULK_trend_t* trend, const int32_t* wind_speed_kmh, const int32_t* unit_x, const int32_t* unit_y, uint32_t vectors_number) {
+    // Local variables.
+    SEN15901_BULK_vector_t kmh;
+    SEN15901_BULK_vector_t vector_x;
+    SEN15901_BULK_vector_t vector_y;
+    SEN15901_BULK_vector_t sum_x = SEN15901_BULK_zero();
+    SEN15901_BULK_vector_t sum_y = SEN15901_BULK_zero();
+    SEN15901_BULK_vector_t magnitude_sum_x = SEN15901_BULK_zero();
+    SEN15901_BULK_vector_t magnitude_sum_y = SEN15901_BULK_zero();
+#ifndef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    int64_t magnitude_x = 0;
+    int64_t magnitude_y = 0;
+#endif
+    uint32_t idx = 0;
+    // Products and sums of the whole block in vector registers.
+    for (idx = 0; idx < vectors_number; idx += SEN15901_BULK_SIMD_WIDTH) {
+        kmh = SEN15901_BULK_load(&(wind_speed_kmh[idx]));
+        vector_x = SEN15901_BULK_mullo_epi32(kmh, SEN15901_BULK_load(&(unit_x[idx])));
+        vector_y = SEN15901_BULK_mullo_epi32(kmh, SEN15901_BULK_load(&(unit_y[idx])));
+#ifndef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+        // Apply the current scale.
+        vector_x = SEN15901_BULK_sra_epi32(vector_x, (int) (trend->trend_point_shift));
+        vector_y = SEN15901_BULK_sra_epi32(vector_y, (int) (trend->trend_point_shift));
+#endif
+        _SEN15901_BULK_sum_vectors(vector_x, &sum_x, &magnitude_sum_x);
+        _SEN15901_BULK_sum_vectors(vector_y, &sum_y, &magnitude_sum_y);
+    }
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    trend->trend_point_x += _SEN15901_BULK_sum_epi64(sum_x);
+    trend->trend_point_y += _SEN15901_BULK_sum_epi64(sum_y);
+#else
+    // When no intermediate sum can reach the limit, the driver would not have rescaled within the block.
+    magnitude_x = _SEN15901_BULK_sum_epi64(magnitude_sum_x) + ((trend->trend_point_x < 0) ? (-((int64_t) trend->trend_point_x)) : ((int64_t) trend->trend_point_x));
+    magnitude_y = _SEN15901_BULK_sum_epi64(magnitude_sum_y) + ((trend->trend_point_y < 0) ? (-((int64_t) trend->trend_point_y)) : ((int64_t) trend->trend_point_y));
+    if ((magnitude_x <= SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) && (magnitude_y <= SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT)) {
+        trend->trend_point_x += (int32_t) _SEN15901_BULK_sum_epi64(sum_x);
+        trend->trend_point_y += (int32_t) _SEN15901_BULK_sum_epi64(sum_y);
+    }
+    else {
+        // Rescaling occurs within the block: replay the driver sequence.
+        for (idx = 0; idx < vectors_number; idx++) {
+            _SEN15901_BULK_add_vector(trend, _SEN15901_BULK_get_vector(wind_speed_kmh[idx], unit_x[idx]), _SEN15901_BULK_get_vector(wind_speed_kmh[idx], unit_y[idx]));
+        }
+    }
+#endif
+}
+#endif
+
+/*** SEN15901 BULK functions ***/
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_BULK_get_wind_speed(const uint32_t* wind_speed_edge_count, uint32_t* wind_speed_mh, uint32_t samples_number) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t idx = 0;
+    // Check parameters.
+    if ((wind_speed_edge_count == NULL) || (wind_speed_mh == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Simple loop left to the compiler auto-vectorization.
+    for (idx = 0; idx < samples_number; idx++) {
+        wind_speed_mh[idx] = (wind_speed_edge_count[idx] * SEN15901_WIND_SPEED_1HZ_TO_MH) / (SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_BULK_get_rainfall(const uint32_t* rain_edge_count, int32_t* rainfall_um, uint32_t samples_number) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t idx = 0;
+    // Check parameters.
+    if ((rain_edge_count == NULL) || (rainfall_um == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Simple loop left to the compiler auto-vectorization.
+    for (idx = 0; idx < samples_number; idx++) {
+        rainfall_um[idx] = (int32_t) (rain_edge_count[idx] * SEN15901_RAIN_EDGE_TO_UM);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_BULK_get_wind_direction(const int32_t* wind_direction_ratio_permille, uint8_t* wind_direction_index, int32_t* wind_direction_degrees, uint32_t samples_number) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint8_t error_flag = 0;
+    uint32_t idx = 0;
+#if (SEN15901_BULK_SIMD_WIDTH > 1)
+    int32_t indexes[SEN15901_BULK_SIMD_WIDTH];
+    uint8_t block_error_flag = 0;
+    uint8_t lane = 0;
+#endif
+    // Check parameters.
+    if ((wind_direction_ratio_permille == NULL) || (wind_direction_index == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#if (SEN15901_BULK_SIMD_WIDTH > 1)
+    // Full vectors.
+    for (idx = 0; (idx + SEN15901_BULK_SIMD_WIDTH) <= samples_number; idx += SEN15901_BULK_SIMD_WIDTH) {
+        _SEN15901_BULK_get_wind_direction_indexes(&(wind_direction_ratio_permille[idx]), indexes, &block_error_flag);
+        error_flag |= block_error_flag;
+        for (lane = 0; lane < SEN15901_BULK_SIMD_WIDTH; lane++) {
+            wind_direction_index[idx + lane] = (uint8_t) indexes[lane];
+        }
+    }
+#endif
+    // Remaining samples.
+    for (; idx < samples_number; idx++) {
+        wind_direction_index[idx] = _SEN15901_BULK_get_wind_direction_index(wind_direction_ratio_permille[idx]);
+        error_flag |= (wind_direction_index[idx] == SEN15901_BULK_WIND_DIRECTION_INDEX_ERROR) ? 1 : 0;
+    }
+    // Map indexes to angles.
+    if (wind_direction_degrees != NULL) {
+        for (idx = 0; idx < samples_number; idx++) {
+            wind_direction_degrees[idx] = (wind_direction_index[idx] < SEN15901_WIND_DIRECTIONS_NUMBER) ? ((int32_t) SEN15901_WIND_DIRECTION_ANGLE_DEGREES[wind_direction_index[idx]]) : SEN15901_BULK_WIND_DIRECTION_DEGREES_ERROR;
+        }
+    }
+    if (error_flag != 0) {
+        status = SEN15901_ERROR_RESISTOR_DIVIDER_RATIO;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_BULK_trend_init(SEN15901_BULK_trend_t* trend) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint8_t idx = 0;
+    // Check parameter.
+    if (trend == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Reset trend point.
+    trend->trend_point_x = 0;
+    trend->trend_point_y = 0;
+#ifndef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    trend->trend_point_shift = 0;
+#endif
+    // Unit vectors of each direction.
+    for (idx = 0; idx < SEN15901_WIND_DIRECTIONS_NUMBER; idx++) {
+        trend->direction_x[idx] = (int32_t) MATH_COS_TABLE[SEN15901_WIND_DIRECTION_ANGLE_DEGREES[idx]];
+        trend->direction_y[idx] = (int32_t) MATH_SIN_TABLE[SEN15901_WIND_DIRECTION_ANGLE_DEGREES[idx]];
+    }
+    trend->direction_x[SEN15901_BULK_WIND_DIRECTION_INDEX_NULL] = 0;
+    trend->direction_y[SEN15901_BULK_WIND_DIRECTION_INDEX_NULL] = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_BULK_trend_add(SEN15901_BULK_trend_t* trend, const uint32_t* wind_speed_mh, const uint8_t* wind_direction_index, uint32_t samples_number) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint8_t direction_index = 0;
+    uint32_t idx = 0;
+#if (SEN15901_BULK_SIMD_WIDTH > 1)
+    int32_t wind_speed_kmh[SEN15901_BULK_BLOCK_SIZE];
+    int32_t unit_x[SEN15901_BULK_BLOCK_SIZE];
+    int32_t unit_y[SEN15901_BULK_BLOCK_SIZE];
+    uint32_t lane = 0;
+#endif
+    // Check parameters.
+    if ((trend == NULL) || (wind_speed_mh == NULL) || (wind_direction_index == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+#if (SEN15901_BULK_SIMD_WIDTH > 1)
+    // Full blocks, invalid samples are replaced by a null vector which does not change the trend point.
+    for (idx = 0; (idx + SEN15901_BULK_BLOCK_SIZE) <= samples_number; idx += SEN15901_BULK_BLOCK_SIZE) {
+        for (lane = 0; lane < SEN15901_BULK_BLOCK_SIZE; lane++) {
+            direction_index = wind_direction_index[idx + lane];
+            direction_index = (direction_index < SEN15901_WIND_DIRECTIONS_NUMBER) ? direction_index : SEN15901_BULK_WIND_DIRECTION_INDEX_NULL;
+            wind_speed_kmh[lane] = (int32_t) (wind_speed_mh[idx + lane] / 1000);
+            unit_x[lane] = trend->direction_x[direction_index];
+            unit_y[lane] = trend->direction_y[direction_index];
+        }
+        _SEN15901_BULK_add_vectors(trend, wind_speed_kmh, unit_x, unit_y, SEN15901_BULK_BLOCK_SIZE);
+    }
+#endif
+    // Remaining samples.
+    for (; idx < samples_number; idx++) {
+        direction_index = wind_direction_index[idx];
+        if (direction_index >= SEN15901_WIND_DIRECTIONS_NUMBER) continue;
+        _SEN15901_BULK_add_vector(trend, _SEN15901_BULK_get_vector((int32_t) (wind_speed_mh[idx] / 1000), trend->direction_x[direction_index]), _SEN15901_BULK_get_vector((int32_t) (wind_speed_mh[idx] / 1000), trend->direction_y[direction_index]));
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_BULK_trend_get_direction(SEN15901_BULK_trend_t* trend, int32_t* average_direction_degrees, SEN15901_wind_direction_status_t* direction_status) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    MATH_status_t math_status = MATH_SUCCESS;
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    int64_t x = 0;
+    int64_t y = 0;
+#endif
+    int32_t trend_point_x = 0;
+    int32_t trend_point_y = 0;
+    // Check parameters.
+    if ((trend == NULL) || (average_direction_degrees == NULL) || (direction_status == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Reset output status.
+    (*direction_status) = SEN15901_WIND_DIRECTION_STATUS_UNDEFINED;
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    // Scale trend point down to 32 bits, the angle is unchanged.
+    x = (trend->trend_point_x);
+    y = (trend->trend_point_y);
+    while ((x > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (x < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT)) || (y > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (y < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT))) {
+        x >>= 1;
+        y >>= 1;
+    }
+    trend_point_x = (int32_t) x;
+    trend_point_y = (int32_t) y;
+#else
+    trend_point_x = (trend->trend_point_x);
+    trend_point_y = (trend->trend_point_y);
+#endif
+    if ((trend_point_x != 0) || (trend_point_y != 0)) {
+        // Compute trend point angle.
+        math_status = MATH_atan2(trend_point_x, trend_point_y, average_direction_degrees);
+        MATH_exit_error(SEN15901_ERROR_BASE_MATH);
+        // Update output status.
+        (*direction_status) = SEN15901_WIND_DIRECTION_STATUS_AVAILABLE;
+    }
+errors:
+    return status;
+}
+
+#endif /* SEN15901_DRIVER_DISABLE */
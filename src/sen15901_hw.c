@@ -18,47 +18,112 @@
 /*** SEN15901 HW functions ***/
 
 /*******************************************************************/
-SEN15901_status_t __attribute__((weak)) SEN15901_HW_init(SEN15901_HW_configuration_t* configuration) {
+SEN15901_status_t __attribute__((weak)) SEN15901_HW_init(SEN15901_context_t* context, SEN15901_HW_configuration_t* configuration) {
     // Local variables.
     SEN15901_status_t status = SEN15901_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
     /* To be implemented */
+    UNUSED(context);
     UNUSED(configuration);
     return status;
 }
 
 /*******************************************************************/
-SEN15901_status_t __attribute__((weak)) SEN15901_HW_de_init(void) {
+SEN15901_status_t __attribute__((weak)) SEN15901_HW_de_init(SEN15901_context_t* context) {
     // Local variables.
     SEN15901_status_t status = SEN15901_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
     /* To be implemented */
+    UNUSED(context);
     return status;
 }
 
 /*******************************************************************/
-SEN15901_status_t __attribute__((weak)) SEN15901_HW_set_wind_speed_interrupt(uint8_t enable) {
+SEN15901_status_t __attribute__((weak)) SEN15901_HW_set_wind_speed_interrupt(SEN15901_context_t* context, uint8_t enable) {
     // Local variables.
     SEN15901_status_t status = SEN15901_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
     /* To be implemented */
+    UNUSED(context);
     UNUSED(enable);
     return status;
 }
 
 /*******************************************************************/
-SEN15901_status_t __attribute__((weak)) SEN15901_HW_set_rainfall_interrupt(uint8_t enable) {
+SEN15901_status_t __attribute__((weak)) SEN15901_HW_set_rainfall_interrupt(SEN15901_context_t* context, uint8_t enable) {
     // Local variables.
     SEN15901_status_t status = SEN15901_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
     /* To be implemented */
+    UNUSED(context);
     UNUSED(enable);
     return status;
 }
 
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
 /*******************************************************************/
-SEN15901_status_t __attribute__((weak)) SEN15901_HW_adc_get_wind_direction_ratio(int32_t* wind_direction_ratio_permille) {
+SEN15901_status_t __attribute__((weak)) SEN15901_HW_adc_start_wind_direction_conversion(SEN15901_context_t* context, int32_t* wind_direction_ratios_permille, uint8_t ratios_count) {
     // Local variables.
     SEN15901_status_t status = SEN15901_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
     /* To be implemented */
+    UNUSED(context);
+    UNUSED(wind_direction_ratios_permille);
+    UNUSED(ratios_count);
+    return status;
+}
+#elif (defined SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING)
+/*******************************************************************/
+SEN15901_status_t __attribute__((weak)) SEN15901_HW_adc_get_wind_direction_ratios(SEN15901_context_t* context, int32_t* wind_direction_ratios_permille, uint8_t ratios_count) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
+    /* To be implemented */
+    UNUSED(context);
+    UNUSED(wind_direction_ratios_permille);
+    UNUSED(ratios_count);
+    return status;
+}
+#else
+/*******************************************************************/
+SEN15901_status_t __attribute__((weak)) SEN15901_HW_adc_get_wind_direction_ratio(SEN15901_context_t* context, int32_t* wind_direction_ratio_permille) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
+    /* To be implemented */
+    UNUSED(context);
     UNUSED(wind_direction_ratio_permille);
     return status;
 }
+#endif
+
+#ifdef SEN15901_DRIVER_TICKLESS
+/*******************************************************************/
+SEN15901_status_t __attribute__((weak)) SEN15901_HW_set_wakeup_timer(SEN15901_context_t* context, uint32_t delay_seconds) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
+    /* To be implemented */
+    UNUSED(context);
+    UNUSED(delay_seconds);
+    return status;
+}
+#endif
+
+#if ((defined SEN15901_DRIVER_EDGE_RING_SIZE) || (defined SEN15901_DRIVER_EDGE_DEBOUNCE))
+/*******************************************************************/
+SEN15901_status_t __attribute__((weak)) SEN15901_HW_get_timestamp_us(SEN15901_context_t* context, uint32_t* timestamp_us) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
+    /* To be implemented */
+    UNUSED(context);
+    UNUSED(timestamp_us);
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+/*******************************************************************/
+SEN15901_status_t __attribute__((weak)) SEN15901_HW_get_cycle_count(SEN15901_context_t* context, uint32_t* cycle_count) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_ERROR_HW_FUNCTION_NOT_IMPLEMENTED;
+    /* To be implemented */
+    UNUSED(context);
+    UNUSED(cycle_count);
+    return status;
+}
+#endif
 
 #endif /* SEN15901_DRIVER_DISABLE */
@@ -0,0 +1,490 @@
+/*
+ * sen15901_hw_sim.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "sen15901_hw_sim.h"
+
+#ifndef SEN15901_DRIVER_DISABLE_FLAGS_FILE
+#include "sen15901_driver_flags.h"
+#endif
+#include "sen15901.h"
+#include "sen15901_hw.h"
+#include "types.h"
+
+#if (!(defined SEN15901_DRIVER_DISABLE) && (defined SEN15901_DRIVER_HW_SIMULATION))
+
+#include <time.h>
+
+/*** SEN15901 HW SIM local macros ***/
+
+#define SEN15901_HW_SIM_SECOND_US           1000000
+
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+#define SEN15901_HW_SIM_SLOTS_PER_SECOND    SEN15901_DRIVER_WIND_GUST_SAMPLES_PER_SECOND
+#else
+#define SEN15901_HW_SIM_SLOTS_PER_SECOND    1
+#endif
+
+/*** SEN15901 HW SIM local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    SEN15901_context_t* context;
+    SEN15901_HW_configuration_t configuration;
+    uint8_t wind_speed_interrupt_enable;
+    uint8_t rainfall_interrupt_enable;
+    uint32_t time_us;
+    int32_t wind_direction_ratio_permille;
+    uint32_t adc_conversion_count;
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+    uint8_t adc_conversion_request;
+    int32_t* adc_ratios_permille;
+    uint8_t adc_ratios_count;
+#endif
+#ifdef SEN15901_DRIVER_TICKLESS
+    uint32_t wakeup_delay_seconds;
+    uint32_t wakeup_elapsed_seconds;
+#endif
+} SEN15901_HW_SIM_instance_t;
+
+/*** SEN15901 HW SIM local global variables ***/
+
+static SEN15901_HW_SIM_instance_t sen15901_hw_sim_instance[SEN15901_HW_SIM_INSTANCES_NUMBER];
+
+/*** SEN15901 HW SIM local functions ***/
+
+/*******************************************************************/
+static SEN15901_HW_SIM_instance_t* _SEN15901_HW_SIM_get_instance(SEN15901_context_t* context) {
+    // Local variables.
+    SEN15901_HW_SIM_instance_t* instance = NULL;
+    uint8_t idx = 0;
+    // Search instance attached to the context.
+    for (idx = 0; idx < SEN15901_HW_SIM_INSTANCES_NUMBER; idx++) {
+        if ((context != NULL) && (sen15901_hw_sim_instance[idx].context == context)) {
+            instance = &(sen15901_hw_sim_instance[idx]);
+            break;
+        }
+    }
+    return instance;
+}
+
+/*******************************************************************/
+static uint64_t _SEN15901_HW_SIM_get_time_ns(void) {
+    // Local variables.
+    struct timespec time;
+    // Read host monotonic clock.
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return ((((uint64_t) time.tv_sec) * 1000000000) + ((uint64_t) time.tv_nsec));
+}
+
+/*******************************************************************/
+static void _SEN15901_HW_SIM_wind_speed_edge(SEN15901_HW_SIM_instance_t* instance, SEN15901_HW_SIM_statistics_t* statistics) {
+    // Local variables.
+    uint64_t time_ns = 0;
+    // Check interrupt state.
+    if (instance->wind_speed_interrupt_enable == 0) return;
+    // Call edge or capture interrupt.
+    time_ns = _SEN15901_HW_SIM_get_time_ns();
+#ifdef SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT
+    instance->configuration.wind_speed_capture_irq_callback(instance->context, instance->time_us);
+#else
+    instance->configuration.wind_speed_edge_irq_callback(instance->context);
+#endif
+    statistics->edge_time_ns += (_SEN15901_HW_SIM_get_time_ns() - time_ns);
+    statistics->edge_count++;
+}
+
+/*******************************************************************/
+static void _SEN15901_HW_SIM_rainfall_edge(SEN15901_HW_SIM_instance_t* instance, SEN15901_HW_SIM_statistics_t* statistics) {
+    // Check interrupt state.
+    if (instance->rainfall_interrupt_enable == 0) return;
+    instance->configuration.rainfall_edge_irq_callback(instance->context);
+    statistics->rain_edge_count++;
+}
+
+/*******************************************************************/
+static uint32_t _SEN15901_HW_SIM_get_edge_offset_us(uint32_t edge_idx, uint32_t edge_count) {
+    // Edges evenly spread over the second, none at its boundaries.
+    if (edge_idx >= edge_count) return SEN15901_HW_SIM_SECOND_US;
+    return (uint32_t) (((((uint64_t) edge_idx) * 2 + 1) * SEN15901_HW_SIM_SECOND_US) / (((uint64_t) edge_count) * 2));
+}
+
+/*******************************************************************/
+static void _SEN15901_HW_SIM_convert(SEN15901_HW_SIM_instance_t* instance, int32_t* wind_direction_ratios_permille, uint8_t ratios_count) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Same ratio for all conversions of the burst.
+    for (idx = 0; idx < ratios_count; idx++) {
+        wind_direction_ratios_permille[idx] = instance->wind_direction_ratio_permille;
+    }
+    instance->adc_conversion_count++;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_HW_SIM_tick_second(SEN15901_HW_SIM_instance_t* instance, SEN15901_HW_SIM_statistics_t* statistics) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t adc_conversion_count = instance->adc_conversion_count;
+    uint64_t time_ns = 0;
+#ifdef SEN15901_DRIVER_TICKLESS
+    // Check wake-up timer.
+    if (instance->wakeup_delay_seconds == 0) goto errors;
+    instance->wakeup_elapsed_seconds++;
+    if (instance->wakeup_elapsed_seconds < instance->wakeup_delay_seconds) goto errors;
+    instance->wakeup_elapsed_seconds = 0;
+#endif
+    // Call tick interrupt and process function.
+    time_ns = _SEN15901_HW_SIM_get_time_ns();
+    instance->configuration.tick_second_irq_callback(instance->context);
+    status = SEN15901_instance_process(instance->context);
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+    // Complete conversion immediately and process the result.
+    if ((status == SEN15901_SUCCESS) && (instance->adc_conversion_request != 0)) {
+        instance->adc_conversion_request = 0;
+        _SEN15901_HW_SIM_convert(instance, instance->adc_ratios_permille, instance->adc_ratios_count);
+        instance->configuration.adc_done_irq_callback(instance->context);
+        status = SEN15901_instance_process(instance->context);
+    }
+#endif
+    time_ns = (_SEN15901_HW_SIM_get_time_ns() - time_ns);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Split ticks with and without wind direction sample.
+    if (instance->adc_conversion_count != adc_conversion_count) {
+        statistics->wind_direction_time_ns += time_ns;
+        statistics->wind_direction_sample_count++;
+    }
+    else {
+        statistics->tick_time_ns += time_ns;
+        statistics->tick_count++;
+    }
+errors:
+    return status;
+}
+
+/*** SEN15901 HW functions ***/
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_init(SEN15901_context_t* context, SEN15901_HW_configuration_t* configuration) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = NULL;
+    // Check parameters.
+    if ((context == NULL) || (configuration == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if ((configuration->hw_instance) >= SEN15901_HW_SIM_INSTANCES_NUMBER) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    // Init simulated sensor.
+    instance = &(sen15901_hw_sim_instance[configuration->hw_instance]);
+    instance->context = context;
+    instance->configuration = (*configuration);
+    instance->wind_speed_interrupt_enable = 0;
+    instance->rainfall_interrupt_enable = 0;
+    instance->time_us = 0;
+    instance->wind_direction_ratio_permille = 0;
+    instance->adc_conversion_count = 0;
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+    instance->adc_conversion_request = 0;
+#endif
+#ifdef SEN15901_DRIVER_TICKLESS
+    instance->wakeup_delay_seconds = 0;
+    instance->wakeup_elapsed_seconds = 0;
+#endif
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_de_init(SEN15901_context_t* context) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    // Check instance.
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    // Detach context.
+    instance->context = NULL;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_set_wind_speed_interrupt(SEN15901_context_t* context, uint8_t enable) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    // Check instance.
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    instance->wind_speed_interrupt_enable = enable;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_set_rainfall_interrupt(SEN15901_context_t* context, uint8_t enable) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    // Check instance.
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    instance->rainfall_interrupt_enable = enable;
+errors:
+    return status;
+}
+
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_ADC_ASYNCHRONOUS
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_adc_start_wind_direction_conversion(SEN15901_context_t* context, int32_t* wind_direction_ratios_permille, uint8_t ratios_count) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    // Check instance.
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    // Conversion is completed at the end of the simulated tick.
+    instance->adc_conversion_request = 1;
+    instance->adc_ratios_permille = wind_direction_ratios_permille;
+    instance->adc_ratios_count = ratios_count;
+errors:
+    return status;
+}
+#elif (defined SEN15901_DRIVER_WIND_DIRECTION_OVERSAMPLING)
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_adc_get_wind_direction_ratios(SEN15901_context_t* context, int32_t* wind_direction_ratios_permille, uint8_t ratios_count) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    // Check instance.
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    _SEN15901_HW_SIM_convert(instance, wind_direction_ratios_permille, ratios_count);
+errors:
+    return status;
+}
+#else
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_adc_get_wind_direction_ratio(SEN15901_context_t* context, int32_t* wind_direction_ratio_permille) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    // Check instance.
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    _SEN15901_HW_SIM_convert(instance, wind_direction_ratio_permille, 1);
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_TICKLESS
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_set_wakeup_timer(SEN15901_context_t* context, uint32_t delay_seconds) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    // Check instance.
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    instance->wakeup_delay_seconds = delay_seconds;
+    instance->wakeup_elapsed_seconds = 0;
+errors:
+    return status;
+}
+#endif
+
+#if ((defined SEN15901_DRIVER_EDGE_RING_SIZE) || (defined SEN15901_DRIVER_EDGE_DEBOUNCE))
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_get_timestamp_us(SEN15901_context_t* context, uint32_t* timestamp_us) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    // Check instance.
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    (*timestamp_us) = instance->time_us;
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_get_cycle_count(SEN15901_context_t* context, uint32_t* cycle_count) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    // Check instance.
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    // Host nanoseconds are used as cycles.
+    (*cycle_count) = (uint32_t) _SEN15901_HW_SIM_get_time_ns();
+errors:
+    return status;
+}
+#endif
+
+/*** SEN15901 HW SIM functions ***/
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_SIM_set_wind_direction_ratio(SEN15901_context_t* context, int32_t wind_direction_ratio_permille) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    // Check instance.
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    instance->wind_direction_ratio_permille = wind_direction_ratio_permille;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_SIM_replay(SEN15901_context_t* context, const SEN15901_HW_SIM_trace_second_t* trace, uint32_t trace_size, SEN15901_HW_SIM_statistics_t* statistics) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    uint32_t second_start_us = 0;
+    uint32_t wind_speed_offset_us = 0;
+    uint32_t rain_offset_us = 0;
+    uint32_t wind_speed_edge_count = 0;
+    uint32_t rain_edge_count = 0;
+    uint32_t second_idx = 0;
+    uint32_t wind_speed_edge_idx = 0;
+    uint32_t rain_edge_idx = 0;
+    uint8_t slot_idx = 0;
+    // Check parameters.
+    if ((trace == NULL) || (statistics == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    for (second_idx = 0; second_idx < trace_size; second_idx++) {
+        second_start_us = instance->time_us;
+        wind_speed_edge_count = trace[second_idx].wind_speed_edge_count;
+        rain_edge_count = trace[second_idx].rain_edge_count;
+        instance->wind_direction_ratio_permille = trace[second_idx].wind_direction_ratio_permille;
+        // Spread anemometer and rain gauge edges over the second in time order, with the gust ticks at their sampling instants.
+        wind_speed_edge_idx = 0;
+        rain_edge_idx = 0;
+        for (slot_idx = 0; slot_idx < SEN15901_HW_SIM_SLOTS_PER_SECOND; slot_idx++) {
+            while (1) {
+                wind_speed_offset_us = _SEN15901_HW_SIM_get_edge_offset_us(wind_speed_edge_idx, wind_speed_edge_count);
+                rain_offset_us = _SEN15901_HW_SIM_get_edge_offset_us(rain_edge_idx, rain_edge_count);
+                if (wind_speed_offset_us <= rain_offset_us) {
+                    if ((wind_speed_offset_us * SEN15901_HW_SIM_SLOTS_PER_SECOND) >= (((uint32_t) (slot_idx + 1)) * SEN15901_HW_SIM_SECOND_US)) break;
+                    instance->time_us = (second_start_us + wind_speed_offset_us);
+                    _SEN15901_HW_SIM_wind_speed_edge(instance, statistics);
+                    wind_speed_edge_idx++;
+                }
+                else {
+                    if ((rain_offset_us * SEN15901_HW_SIM_SLOTS_PER_SECOND) >= (((uint32_t) (slot_idx + 1)) * SEN15901_HW_SIM_SECOND_US)) break;
+                    instance->time_us = (second_start_us + rain_offset_us);
+                    _SEN15901_HW_SIM_rainfall_edge(instance, statistics);
+                    rain_edge_idx++;
+                }
+            }
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+            instance->time_us = (second_start_us + ((((uint32_t) (slot_idx + 1)) * SEN15901_HW_SIM_SECOND_US) / SEN15901_HW_SIM_SLOTS_PER_SECOND));
+            instance->configuration.tick_gust_irq_callback(instance->context);
+#endif
+        }
+        // End of second.
+        instance->time_us = (second_start_us + SEN15901_HW_SIM_SECOND_US);
+        status = _SEN15901_HW_SIM_tick_second(instance, statistics);
+        if (status != SEN15901_SUCCESS) goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_SIM_wind_speed_edge(SEN15901_context_t* context, SEN15901_HW_SIM_statistics_t* statistics) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    // Check parameters.
+    if (statistics == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    _SEN15901_HW_SIM_wind_speed_edge(instance, statistics);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_SIM_rainfall_edge(SEN15901_context_t* context, SEN15901_HW_SIM_statistics_t* statistics) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    // Check parameters.
+    if (statistics == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    _SEN15901_HW_SIM_rainfall_edge(instance, statistics);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_HW_SIM_tick_second(SEN15901_context_t* context, SEN15901_HW_SIM_statistics_t* statistics) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_instance_t* instance = _SEN15901_HW_SIM_get_instance(context);
+    // Check parameters.
+    if (statistics == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (instance == NULL) {
+        status = SEN15901_ERROR_HW_INSTANCE;
+        goto errors;
+    }
+    status = _SEN15901_HW_SIM_tick_second(instance, statistics);
+errors:
+    return status;
+}
+
+#endif /* SEN15901_DRIVER_DISABLE */
@@ -0,0 +1,480 @@
+/*
+ * sen15901_log.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "sen15901_log.h"
+
+#ifndef SEN15901_DRIVER_DISABLE_FLAGS_FILE
+#include "sen15901_driver_flags.h"
+#endif
+#include "sen15901.h"
+#include "sen15901_log_hw.h"
+#include "types.h"
+
+#if (!(defined SEN15901_DRIVER_DISABLE) && (defined SEN15901_DRIVER_LOG_BLOCK_SIZE))
+
+/*** SEN15901 LOG local macros ***/
+
+// Block header: used size and records count.
+#define SEN15901_LOG_BLOCK_HEADER_SIZE          2
+#define SEN15901_LOG_BLOCK_SIZE_INDEX           0
+#define SEN15901_LOG_BLOCK_RECORDS_INDEX        1
+
+// Key record: index, speed, gust and direction / rain fields.
+#define SEN15901_LOG_RECORD_SIZE_MAX            20
+
+#define SEN15901_LOG_DIRECTION_SECTOR_BITS      5
+#define SEN15901_LOG_DIRECTION_SECTOR_MASK      ((1 << SEN15901_LOG_DIRECTION_SECTOR_BITS) - 1)
+
+#if ((SEN15901_DRIVER_LOG_BLOCK_SIZE < 32) || (SEN15901_DRIVER_LOG_BLOCK_SIZE > 255))
+#error "SEN15901 driver: SEN15901_DRIVER_LOG_BLOCK_SIZE must be between 32 and 255"
+#endif
+
+/*** SEN15901 LOG local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t first_index;
+    uint32_t size;
+    uint8_t records_count;
+    SEN15901_LOG_record_t record_last;
+} SEN15901_LOG_block_t;
+
+/*** SEN15901 LOG local functions ***/
+
+/*******************************************************************/
+static uint32_t _SEN15901_LOG_zigzag_encode(int32_t value) {
+    // Interleave signs so that small negative values also give small integers.
+    return ((value < 0) ? (((~((uint32_t) value)) << 1) | 1) : (((uint32_t) value) << 1));
+}
+
+/*******************************************************************/
+static int32_t _SEN15901_LOG_zigzag_decode(uint32_t value) {
+    return (int32_t) ((value & 0x01) ? (~(value >> 1)) : (value >> 1));
+}
+
+/*******************************************************************/
+static uint32_t _SEN15901_LOG_encode_varint(uint32_t value, uint8_t* data) {
+    // Local variables.
+    uint32_t size = 0;
+    // 7 bits per byte, MSB set when another byte follows.
+    do {
+        data[size] = (uint8_t) (value & 0x7F);
+        value >>= 7;
+        if (value != 0) {
+            data[size] |= 0x80;
+        }
+        size++;
+    }
+    while (value != 0);
+    return size;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_LOG_decode_varint(SEN15901_LOG_iterator_t* iterator, uint32_t* value) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint8_t byte = 0;
+    uint8_t shift = 0;
+    // Reset result.
+    (*value) = 0;
+    do {
+        // Check chunk end and 32 bits overflow.
+        if (((iterator->offset) >= (iterator->size)) || (shift > 28)) {
+            status = SEN15901_ERROR_LOG_DATA;
+            goto errors;
+        }
+        byte = iterator->data[iterator->offset];
+        iterator->offset++;
+        (*value) |= (((uint32_t) (byte & 0x7F)) << shift);
+        shift = (uint8_t) (shift + 7);
+    }
+    while ((byte & 0x80) != 0);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static uint32_t _SEN15901_LOG_quantize_speed(int32_t speed_mh) {
+    return (speed_mh < 0) ? 0 : ((((uint32_t) speed_mh) + (SEN15901_LOG_WIND_SPEED_RESOLUTION_MH / 2)) / SEN15901_LOG_WIND_SPEED_RESOLUTION_MH);
+}
+
+/*******************************************************************/
+static uint32_t _SEN15901_LOG_encode_record(const SEN15901_LOG_record_t* record, const SEN15901_LOG_record_t* record_last, uint8_t* data) {
+    // Local variables.
+    uint32_t size = 0;
+    uint32_t average_speed = _SEN15901_LOG_quantize_speed(record->average_speed_mh);
+    uint32_t gust_speed = _SEN15901_LOG_quantize_speed(record->gust_speed_mh);
+    // Direction sector and rain tips share a single field, which is 1 byte without rain.
+    uint32_t direction_rain = ((record->rain_edge_count) << SEN15901_LOG_DIRECTION_SECTOR_BITS) | ((uint32_t) ((record->direction_sector) & SEN15901_LOG_DIRECTION_SECTOR_MASK));
+    if (record_last == NULL) {
+        // Key record with absolute values.
+        size += _SEN15901_LOG_encode_varint(record->index, &(data[size]));
+        size += _SEN15901_LOG_encode_varint(average_speed, &(data[size]));
+        size += _SEN15901_LOG_encode_varint(gust_speed, &(data[size]));
+    }
+    else {
+        // Speeds relative to the previous record.
+        size += _SEN15901_LOG_encode_varint(_SEN15901_LOG_zigzag_encode((int32_t) (average_speed - _SEN15901_LOG_quantize_speed(record_last->average_speed_mh))), &(data[size]));
+        size += _SEN15901_LOG_encode_varint(_SEN15901_LOG_zigzag_encode((int32_t) (gust_speed - _SEN15901_LOG_quantize_speed(record_last->gust_speed_mh))), &(data[size]));
+    }
+    size += _SEN15901_LOG_encode_varint(direction_rain, &(data[size]));
+    return size;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_LOG_init_context(SEN15901_LOG_context_t* log, uint8_t* buffer, uint32_t buffer_size) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((log == NULL) || (buffer == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // One block is written while another one is read.
+    if (buffer_size < (2 * SEN15901_DRIVER_LOG_BLOCK_SIZE)) {
+        status = SEN15901_ERROR_LOG_BUFFER_SIZE;
+        goto errors;
+    }
+    // Init context.
+    log->buffer = buffer;
+    log->blocks_number = (buffer_size / SEN15901_DRIVER_LOG_BLOCK_SIZE);
+    log->head = 0;
+    log->tail = 0;
+    log->write_offset = 0;
+    log->write_records_count = 0;
+    log->read_pending_flag = 0;
+    log->record_index = 0;
+    log->lost_count = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_LOG_write_header(SEN15901_LOG_context_t* log) {
+    // Local variables.
+    uint8_t header[SEN15901_LOG_BLOCK_HEADER_SIZE];
+    // Header is written after the records, so that a record interrupted by a reset is not referenced.
+    header[SEN15901_LOG_BLOCK_SIZE_INDEX] = (uint8_t) (log->write_offset);
+    header[SEN15901_LOG_BLOCK_RECORDS_INDEX] = log->write_records_count;
+    return SEN15901_LOG_HW_write(log, (((log->head) % (log->blocks_number)) * SEN15901_DRIVER_LOG_BLOCK_SIZE), header, SEN15901_LOG_BLOCK_HEADER_SIZE);
+}
+
+/*******************************************************************/
+static void _SEN15901_LOG_scan_block(SEN15901_LOG_context_t* log, uint32_t block_index, SEN15901_LOG_block_t* block_info) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_LOG_iterator_t iterator;
+    SEN15901_LOG_record_t record;
+    const uint8_t* block = &(log->buffer[block_index * SEN15901_DRIVER_LOG_BLOCK_SIZE]);
+    uint32_t size = block[SEN15901_LOG_BLOCK_SIZE_INDEX];
+    uint8_t record_available = 0;
+    // Erased or corrupted header.
+    if ((size < SEN15901_LOG_BLOCK_HEADER_SIZE) || (size > SEN15901_DRIVER_LOG_BLOCK_SIZE)) {
+        size = SEN15901_LOG_BLOCK_HEADER_SIZE;
+    }
+    block_info->size = SEN15901_LOG_BLOCK_HEADER_SIZE;
+    block_info->records_count = 0;
+    // Keep the complete records only.
+    SEN15901_LOG_iterator_init(&iterator, &(block[SEN15901_LOG_BLOCK_HEADER_SIZE]), (size - SEN15901_LOG_BLOCK_HEADER_SIZE));
+    while (1) {
+        status = SEN15901_LOG_iterator_next(&iterator, &record, &record_available);
+        if ((status != SEN15901_SUCCESS) || (record_available == 0)) break;
+        if ((block_info->records_count) == 0) {
+            block_info->first_index = record.index;
+        }
+        block_info->size = (SEN15901_LOG_BLOCK_HEADER_SIZE + iterator.offset);
+        block_info->records_count++;
+        block_info->record_last = record;
+    }
+}
+
+/*** SEN15901 LOG functions ***/
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_LOG_init(SEN15901_LOG_context_t* log, uint8_t* buffer, uint32_t buffer_size) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t block_index = 0;
+    // Init context.
+    status = _SEN15901_LOG_init_context(log, buffer, buffer_size);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Erase blocks of a previous session, which would be taken back by the recovery.
+    for (block_index = 0; block_index < (log->blocks_number); block_index++) {
+        status = SEN15901_LOG_HW_erase_block(log, block_index);
+        if (status != SEN15901_SUCCESS) goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_LOG_recover(SEN15901_LOG_context_t* log, uint8_t* buffer, uint32_t buffer_size) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_LOG_block_t block_info;
+    SEN15901_LOG_block_t head_info;
+    uint32_t block_index = 0;
+    uint32_t head_index = 0;
+    uint32_t next_first_index = 0;
+    uint32_t closed_blocks_count = 0;
+    // Init context.
+    status = _SEN15901_LOG_init_context(log, buffer, buffer_size);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Last written block is the one with the most recent key record.
+    head_info.records_count = 0;
+    for (block_index = 0; block_index < (log->blocks_number); block_index++) {
+        _SEN15901_LOG_scan_block(log, block_index, &block_info);
+        if ((block_info.records_count != 0) && ((head_info.records_count == 0) || (((int32_t) (block_info.first_index - head_info.first_index)) > 0))) {
+            head_info = block_info;
+            head_index = block_index;
+        }
+    }
+    // Empty storage.
+    if (head_info.records_count == 0) goto errors;
+    // Previous blocks are kept as long as their indexes are decreasing (released blocks are erased).
+    next_first_index = head_info.first_index;
+    for (closed_blocks_count = 0; closed_blocks_count < ((log->blocks_number) - 1); closed_blocks_count++) {
+        block_index = ((head_index + (log->blocks_number) - closed_blocks_count - 1) % (log->blocks_number));
+        _SEN15901_LOG_scan_block(log, block_index, &block_info);
+        if ((block_info.records_count == 0) || (((int32_t) (next_first_index - block_info.first_index)) <= 0)) break;
+        next_first_index = block_info.first_index;
+    }
+    // Reopen last block after its last complete record.
+    log->head = (head_index + (log->blocks_number));
+    log->tail = ((log->head) - closed_blocks_count);
+    log->write_offset = head_info.size;
+    log->write_records_count = head_info.records_count;
+    log->record_index = ((head_info.record_last.index) + 1);
+    log->record_last = head_info.record_last;
+    // Drop truncated record from the header.
+    if ((log->buffer[(head_index * SEN15901_DRIVER_LOG_BLOCK_SIZE) + SEN15901_LOG_BLOCK_SIZE_INDEX] != (log->write_offset)) || (log->buffer[(head_index * SEN15901_DRIVER_LOG_BLOCK_SIZE) + SEN15901_LOG_BLOCK_RECORDS_INDEX] != (log->write_records_count))) {
+        status = _SEN15901_LOG_write_header(log);
+        if (status != SEN15901_SUCCESS) goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_LOG_append(SEN15901_LOG_context_t* log, const SEN15901_LOG_record_t* record) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_LOG_record_t record_new;
+    uint8_t data[SEN15901_LOG_RECORD_SIZE_MAX];
+    uint8_t* block = NULL;
+    uint32_t size = 0;
+    // Check parameters.
+    if ((log == NULL) || (record == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Number records even when they are lost.
+    record_new = (*record);
+    record_new.index = log->record_index;
+    log->record_index++;
+    // Encode relatively to the previous record of the current block.
+    if ((log->write_offset) != 0) {
+        size = _SEN15901_LOG_encode_record(&record_new, &(log->record_last), data);
+        if (((log->write_offset) + size) > SEN15901_DRIVER_LOG_BLOCK_SIZE) {
+            // Close full block.
+            log->head++;
+            log->write_offset = 0;
+        }
+    }
+    if ((log->write_offset) == 0) {
+        // Make room for a new block.
+        if (((log->head) - (log->tail)) >= (log->blocks_number)) {
+            // Never overwrite the block being uploaded.
+            if (log->read_pending_flag != 0) {
+                log->lost_count++;
+                status = SEN15901_ERROR_LOG_FULL;
+                goto errors;
+            }
+            block = &(log->buffer[((log->tail) % (log->blocks_number)) * SEN15901_DRIVER_LOG_BLOCK_SIZE]);
+            log->lost_count += block[SEN15901_LOG_BLOCK_RECORDS_INDEX];
+            log->tail++;
+        }
+        // Start block with a key record.
+        status = SEN15901_LOG_HW_erase_block(log, ((log->head) % (log->blocks_number)));
+        if (status != SEN15901_SUCCESS) goto errors;
+        log->write_offset = SEN15901_LOG_BLOCK_HEADER_SIZE;
+        log->write_records_count = 0;
+        size = _SEN15901_LOG_encode_record(&record_new, NULL, data);
+    }
+    // Write record then header.
+    status = SEN15901_LOG_HW_write(log, ((((log->head) % (log->blocks_number)) * SEN15901_DRIVER_LOG_BLOCK_SIZE) + (log->write_offset)), data, size);
+    if (status != SEN15901_SUCCESS) goto errors;
+    log->write_offset += size;
+    log->write_records_count++;
+    log->record_last = record_new;
+    status = _SEN15901_LOG_write_header(log);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_LOG_append_snapshot(SEN15901_LOG_context_t* log, const SEN15901_snapshot_t* snapshot) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_LOG_record_t record;
+    // Check parameter.
+    if (snapshot == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Convert snapshot.
+    record.index = 0;
+    record.average_speed_mh = snapshot->average_speed_mh;
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    record.gust_speed_mh = snapshot->gust_speed_mh;
+#else
+    record.gust_speed_mh = snapshot->peak_speed_mh;
+#endif
+    record.direction_sector = SEN15901_LOG_DIRECTION_SECTOR_UNDEFINED;
+    if ((snapshot->direction_status) == SEN15901_WIND_DIRECTION_STATUS_AVAILABLE) {
+        record.direction_sector = (uint8_t) ((((snapshot->average_direction_degrees) * SEN15901_WIND_ROSE_SECTORS_NUMBER + 180) / 360) % SEN15901_WIND_ROSE_SECTORS_NUMBER);
+    }
+    record.rain_edge_count = (uint32_t) ((snapshot->rainfall_um) / SEN15901_RAIN_EDGE_TO_UM);
+    status = SEN15901_LOG_append(log, &record);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_LOG_flush(SEN15901_LOG_context_t* log) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameter.
+    if (log == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Close current block if it is not empty.
+    if ((log->write_offset) != 0) {
+        log->head++;
+        log->write_offset = 0;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_LOG_read(SEN15901_LOG_context_t* log, const uint8_t** chunk, uint32_t* chunk_size) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint8_t* block = NULL;
+    // Check parameters.
+    if ((log == NULL) || (chunk == NULL) || (chunk_size == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*chunk) = NULL;
+    (*chunk_size) = 0;
+    // Check closed blocks.
+    if ((log->head) == (log->tail)) goto errors;
+    // Lock oldest block until release.
+    block = &(log->buffer[((log->tail) % (log->blocks_number)) * SEN15901_DRIVER_LOG_BLOCK_SIZE]);
+    (*chunk) = &(block[SEN15901_LOG_BLOCK_HEADER_SIZE]);
+    (*chunk_size) = (uint32_t) (block[SEN15901_LOG_BLOCK_SIZE_INDEX] - SEN15901_LOG_BLOCK_HEADER_SIZE);
+    log->read_pending_flag = 1;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_LOG_release(SEN15901_LOG_context_t* log) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameter.
+    if (log == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Free oldest block, erased so that it is not taken back by the recovery.
+    if (log->read_pending_flag != 0) {
+        status = SEN15901_LOG_HW_erase_block(log, ((log->tail) % (log->blocks_number)));
+        if (status != SEN15901_SUCCESS) goto errors;
+        log->tail++;
+        log->read_pending_flag = 0;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_LOG_get_lost_count(SEN15901_LOG_context_t* log, uint32_t* lost_count) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((log == NULL) || (lost_count == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*lost_count) = log->lost_count;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_LOG_iterator_init(SEN15901_LOG_iterator_t* iterator, const uint8_t* chunk, uint32_t chunk_size) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Check parameters.
+    if ((iterator == NULL) || ((chunk == NULL) && (chunk_size != 0))) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    iterator->data = chunk;
+    iterator->size = chunk_size;
+    iterator->offset = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_LOG_iterator_next(SEN15901_LOG_iterator_t* iterator, SEN15901_LOG_record_t* record, uint8_t* record_available) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t value = 0;
+    uint8_t key_flag = 0;
+    // Check parameters.
+    if ((iterator == NULL) || (record == NULL) || (record_available == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*record_available) = 0;
+    if ((iterator->offset) >= (iterator->size)) goto errors;
+    // First record of a chunk is a key record.
+    key_flag = ((iterator->offset) == 0) ? 1 : 0;
+    if (key_flag != 0) {
+        status = _SEN15901_LOG_decode_varint(iterator, &(record->index));
+        if (status != SEN15901_SUCCESS) goto errors;
+    }
+    else {
+        record->index = (iterator->record_last.index) + 1;
+    }
+    // Speeds.
+    status = _SEN15901_LOG_decode_varint(iterator, &value);
+    if (status != SEN15901_SUCCESS) goto errors;
+    record->average_speed_mh = (key_flag != 0) ? ((int32_t) (value * SEN15901_LOG_WIND_SPEED_RESOLUTION_MH)) : ((iterator->record_last.average_speed_mh) + (_SEN15901_LOG_zigzag_decode(value) * SEN15901_LOG_WIND_SPEED_RESOLUTION_MH));
+    status = _SEN15901_LOG_decode_varint(iterator, &value);
+    if (status != SEN15901_SUCCESS) goto errors;
+    record->gust_speed_mh = (key_flag != 0) ? ((int32_t) (value * SEN15901_LOG_WIND_SPEED_RESOLUTION_MH)) : ((iterator->record_last.gust_speed_mh) + (_SEN15901_LOG_zigzag_decode(value) * SEN15901_LOG_WIND_SPEED_RESOLUTION_MH));
+    // Direction and rain.
+    status = _SEN15901_LOG_decode_varint(iterator, &value);
+    if (status != SEN15901_SUCCESS) goto errors;
+    record->direction_sector = (uint8_t) (value & SEN15901_LOG_DIRECTION_SECTOR_MASK);
+    record->rain_edge_count = (value >> SEN15901_LOG_DIRECTION_SECTOR_BITS);
+    // Update decoder state.
+    iterator->record_last = (*record);
+    (*record_available) = 1;
+errors:
+    return status;
+}
+
+#endif /* SEN15901_DRIVER_DISABLE */
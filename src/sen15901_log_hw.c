@@ -0,0 +1,47 @@
+/*
+ * sen15901_log_hw.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "sen15901_log_hw.h"
+
+#ifndef SEN15901_DRIVER_DISABLE_FLAGS_FILE
+#include "sen15901_driver_flags.h"
+#endif
+#include "sen15901.h"
+#include "sen15901_log.h"
+#include "types.h"
+
+#if (!(defined SEN15901_DRIVER_DISABLE) && (defined SEN15901_DRIVER_LOG_BLOCK_SIZE))
+
+/*** SEN15901 LOG HW functions ***/
+
+/*******************************************************************/
+SEN15901_status_t __attribute__((weak)) SEN15901_LOG_HW_erase_block(SEN15901_LOG_context_t* log, uint32_t block_index) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint8_t* block = NULL;
+    uint32_t idx = 0;
+    // RAM storage.
+    block = &(log->buffer[block_index * SEN15901_DRIVER_LOG_BLOCK_SIZE]);
+    for (idx = 0; idx < SEN15901_DRIVER_LOG_BLOCK_SIZE; idx++) {
+        block[idx] = SEN15901_LOG_HW_ERASED_BYTE;
+    }
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t __attribute__((weak)) SEN15901_LOG_HW_write(SEN15901_LOG_context_t* log, uint32_t offset, const uint8_t* data, uint32_t data_size) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t idx = 0;
+    // RAM storage.
+    for (idx = 0; idx < data_size; idx++) {
+        log->buffer[offset + idx] = data[idx];
+    }
+    return status;
+}
+
+#endif /* SEN15901_DRIVER_DISABLE */
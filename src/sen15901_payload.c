@@ -0,0 +1,169 @@
+/*
+ * sen15901_payload.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "sen15901_payload.h"
+
+#ifndef SEN15901_DRIVER_DISABLE_FLAGS_FILE
+#include "sen15901_driver_flags.h"
+#endif
+#include "sen15901.h"
+#include "types.h"
+
+#if (!(defined SEN15901_DRIVER_DISABLE) && (defined SEN15901_DRIVER_PAYLOAD))
+
+/*** SEN15901 PAYLOAD local macros ***/
+
+#if (!(defined SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS) || !(defined SEN15901_DRIVER_PAYLOAD_WIND_SPEED_RESOLUTION_MH) || !(defined SEN15901_DRIVER_PAYLOAD_WIND_DIRECTION_BITS) || \
+     !(defined SEN15901_DRIVER_PAYLOAD_RAINFALL_BITS) || !(defined SEN15901_DRIVER_PAYLOAD_RAINFALL_RESOLUTION_UM))
+#error "SEN15901 driver: payload fields widths and resolutions are required by SEN15901_DRIVER_PAYLOAD"
+#endif
+#if ((SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS == 0) || (SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS > 31) || (SEN15901_DRIVER_PAYLOAD_RAINFALL_BITS == 0) || (SEN15901_DRIVER_PAYLOAD_RAINFALL_BITS > 31))
+#error "SEN15901 driver: payload speed and rainfall widths must be between 1 and 31 bits"
+#endif
+#if ((SEN15901_DRIVER_PAYLOAD_WIND_DIRECTION_BITS == 0) || (SEN15901_DRIVER_PAYLOAD_WIND_DIRECTION_BITS > 9))
+#error "SEN15901 driver: SEN15901_DRIVER_PAYLOAD_WIND_DIRECTION_BITS must be between 1 and 9"
+#endif
+#if ((SEN15901_DRIVER_PAYLOAD_WIND_SPEED_RESOLUTION_MH == 0) || (SEN15901_DRIVER_PAYLOAD_RAINFALL_RESOLUTION_UM == 0))
+#error "SEN15901 driver: payload resolutions must not be zero"
+#endif
+
+#define SEN15901_PAYLOAD_WIND_DIRECTION_SECTORS_NUMBER  (1 << SEN15901_DRIVER_PAYLOAD_WIND_DIRECTION_BITS)
+#define SEN15901_PAYLOAD_VALUE_MAX                      0x7FFFFFFF
+
+/*** SEN15901 PAYLOAD local functions ***/
+
+/*******************************************************************/
+static uint32_t _SEN15901_PAYLOAD_quantize(int32_t value, uint32_t resolution, uint8_t bits) {
+    // Local variables.
+    uint32_t field_max = ((((uint32_t) 1) << bits) - 1);
+    uint32_t field = 0;
+    // Round to the field resolution and saturate.
+    if (value > 0) {
+        field = ((((uint32_t) value) + (resolution >> 1)) / resolution);
+    }
+    return ((field > field_max) ? field_max : field);
+}
+
+/*******************************************************************/
+static int32_t _SEN15901_PAYLOAD_dequantize(uint32_t field, uint32_t resolution) {
+    // Local variables.
+    uint64_t value = (((uint64_t) field) * ((uint64_t) resolution));
+    // Saturate when the field range exceeds the snapshot integers.
+    return (int32_t) ((value > SEN15901_PAYLOAD_VALUE_MAX) ? SEN15901_PAYLOAD_VALUE_MAX : value);
+}
+
+/*******************************************************************/
+static void _SEN15901_PAYLOAD_write_field(uint8_t* payload, uint32_t* bit_offset, uint32_t field, uint8_t bits) {
+    // Local variables.
+    uint8_t idx = 0;
+    uint32_t byte_index = 0;
+    uint8_t bit_mask = 0;
+    // Most significant bit first.
+    for (idx = 0; idx < bits; idx++) {
+        byte_index = ((*bit_offset) >> 3);
+        bit_mask = (uint8_t) (0x80 >> ((*bit_offset) & 0x07));
+        if (((field >> (bits - 1 - idx)) & 0x01) != 0) {
+            payload[byte_index] |= bit_mask;
+        }
+        else {
+            payload[byte_index] &= (uint8_t) (~bit_mask);
+        }
+        (*bit_offset)++;
+    }
+}
+
+/*******************************************************************/
+static uint32_t _SEN15901_PAYLOAD_read_field(const uint8_t* payload, uint32_t* bit_offset, uint8_t bits) {
+    // Local variables.
+    uint8_t idx = 0;
+    uint32_t field = 0;
+    // Most significant bit first.
+    for (idx = 0; idx < bits; idx++) {
+        field <<= 1;
+        field |= ((payload[(*bit_offset) >> 3] >> (7 - ((*bit_offset) & 0x07))) & 0x01);
+        (*bit_offset)++;
+    }
+    return field;
+}
+
+/*** SEN15901 PAYLOAD functions ***/
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_PAYLOAD_encode(const SEN15901_snapshot_t* snapshot, uint8_t* payload, uint8_t payload_size) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t bit_offset = 0;
+    uint32_t wind_direction_sector = 0;
+    uint8_t wind_direction_valid = 0;
+    // Check parameters.
+    if ((snapshot == NULL) || (payload == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (payload_size < SEN15901_PAYLOAD_SIZE_BYTES) {
+        status = SEN15901_ERROR_PAYLOAD_SIZE;
+        goto errors;
+    }
+    // Wind speed.
+    _SEN15901_PAYLOAD_write_field(payload, &bit_offset, _SEN15901_PAYLOAD_quantize(snapshot->average_speed_mh, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_RESOLUTION_MH, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS), SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS);
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    _SEN15901_PAYLOAD_write_field(payload, &bit_offset, _SEN15901_PAYLOAD_quantize(snapshot->gust_speed_mh, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_RESOLUTION_MH, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS), SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS);
+#else
+    _SEN15901_PAYLOAD_write_field(payload, &bit_offset, _SEN15901_PAYLOAD_quantize(snapshot->peak_speed_mh, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_RESOLUTION_MH, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS), SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS);
+#endif
+    // Wind direction sector (clockwise from north), only valid when there was wind.
+    if ((snapshot->direction_status) == SEN15901_WIND_DIRECTION_STATUS_AVAILABLE) {
+        wind_direction_valid = 1;
+        wind_direction_sector = ((((uint32_t) (snapshot->average_direction_degrees)) * SEN15901_PAYLOAD_WIND_DIRECTION_SECTORS_NUMBER + 180) / 360) % SEN15901_PAYLOAD_WIND_DIRECTION_SECTORS_NUMBER;
+    }
+    _SEN15901_PAYLOAD_write_field(payload, &bit_offset, wind_direction_valid, 1);
+    _SEN15901_PAYLOAD_write_field(payload, &bit_offset, wind_direction_sector, SEN15901_DRIVER_PAYLOAD_WIND_DIRECTION_BITS);
+    // Rainfall.
+    _SEN15901_PAYLOAD_write_field(payload, &bit_offset, _SEN15901_PAYLOAD_quantize(snapshot->rainfall_um, SEN15901_DRIVER_PAYLOAD_RAINFALL_RESOLUTION_UM, SEN15901_DRIVER_PAYLOAD_RAINFALL_BITS), SEN15901_DRIVER_PAYLOAD_RAINFALL_BITS);
+    // Padding bits.
+    _SEN15901_PAYLOAD_write_field(payload, &bit_offset, 0, (uint8_t) ((SEN15901_PAYLOAD_SIZE_BYTES * 8) - SEN15901_PAYLOAD_SIZE_BITS));
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_PAYLOAD_decode(const uint8_t* payload, uint8_t payload_size, SEN15901_snapshot_t* snapshot) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t bit_offset = 0;
+    int32_t speed_mh = 0;
+    uint32_t wind_direction_sector = 0;
+    uint8_t wind_direction_valid = 0;
+    // Check parameters.
+    if ((payload == NULL) || (snapshot == NULL)) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (payload_size < SEN15901_PAYLOAD_SIZE_BYTES) {
+        status = SEN15901_ERROR_PAYLOAD_SIZE;
+        goto errors;
+    }
+    // Wind speed.
+    snapshot->average_speed_mh = _SEN15901_PAYLOAD_dequantize(_SEN15901_PAYLOAD_read_field(payload, &bit_offset, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS), SEN15901_DRIVER_PAYLOAD_WIND_SPEED_RESOLUTION_MH);
+    speed_mh = _SEN15901_PAYLOAD_dequantize(_SEN15901_PAYLOAD_read_field(payload, &bit_offset, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS), SEN15901_DRIVER_PAYLOAD_WIND_SPEED_RESOLUTION_MH);
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    snapshot->gust_speed_mh = speed_mh;
+#else
+    snapshot->peak_speed_mh = speed_mh;
+#endif
+    // Wind direction.
+    wind_direction_valid = (uint8_t) _SEN15901_PAYLOAD_read_field(payload, &bit_offset, 1);
+    wind_direction_sector = _SEN15901_PAYLOAD_read_field(payload, &bit_offset, SEN15901_DRIVER_PAYLOAD_WIND_DIRECTION_BITS);
+    snapshot->average_direction_degrees = (int32_t) ((wind_direction_sector * 360) / SEN15901_PAYLOAD_WIND_DIRECTION_SECTORS_NUMBER);
+    snapshot->direction_status = (wind_direction_valid != 0) ? SEN15901_WIND_DIRECTION_STATUS_AVAILABLE : SEN15901_WIND_DIRECTION_STATUS_UNDEFINED;
+    // Rainfall.
+    snapshot->rainfall_um = _SEN15901_PAYLOAD_dequantize(_SEN15901_PAYLOAD_read_field(payload, &bit_offset, SEN15901_DRIVER_PAYLOAD_RAINFALL_BITS), SEN15901_DRIVER_PAYLOAD_RAINFALL_RESOLUTION_UM);
+errors:
+    return status;
+}
+
+#endif /* SEN15901_DRIVER_DISABLE */
@@ -0,0 +1,56 @@
+/*
+ * sen15901_tables.h
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SEN15901_TABLES_H__
+#define __SEN15901_TABLES_H__
+
+#ifndef SEN15901_DRIVER_DISABLE_FLAGS_FILE
+#include "sen15901_driver_flags.h"
+#endif
+#include "maths.h"
+#include "types.h"
+
+#ifndef SEN15901_DRIVER_DISABLE
+
+/*** SEN15901 TABLES macros ***/
+
+// Conversion constants shared by the driver and the bulk decoder, which must give the same results.
+#define SEN15901_WIND_SPEED_1HZ_TO_MH                           2400
+#define SEN15901_WIND_DIRECTIONS_NUMBER                         16
+
+#define SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT               (1 << 30)
+
+#define SEN15901_RESISTOR_DIVIDER_RATIO(rw)                     ((MATH_PERMILLE_MAX * rw) / (rw + SEN15901_DRIVER_WIND_DIRECTION_PULL_UP_RESISTOR_OHMS))
+#define SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(rw1, rw2)     ((SEN15901_RESISTOR_DIVIDER_RATIO(rw1) + SEN15901_RESISTOR_DIVIDER_RATIO(rw2)) >> 1)
+
+/*** SEN15901 TABLES global variables ***/
+
+// Upper ratio of each direction (sorted by increasing resistor value).
+static const int32_t SEN15901_WIND_DIRECTION_RATIO_THRESHOLD[SEN15901_WIND_DIRECTIONS_NUMBER] = {
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(688,   891),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(891,   1000),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(1000,  1410),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(1410,  2200),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(2200,  3140),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(3140,  3900),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(3900,  6570),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(6570,  8200),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(8200,  14120),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(14120, 16000),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(16000, 21880),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(21880, 33000),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(33000, 42120),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(42120, 64900),
+    SEN15901_RESISTOR_DIVIDER_RATIO_THRESHOLD(64900, 120000),
+    MATH_PERMILLE_MAX
+};
+
+static const uint32_t SEN15901_WIND_DIRECTION_ANGLE_DEGREES[SEN15901_WIND_DIRECTIONS_NUMBER] = { 112, 67, 90, 157, 135, 202, 180, 22, 45, 247, 225, 337, 0, 292, 315, 270 };
+
+#endif /* SEN15901_DRIVER_DISABLE */
+
+#endif /* __SEN15901_TABLES_H__ */
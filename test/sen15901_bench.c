@@ -0,0 +1,179 @@
+/*
+ * sen15901_bench.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sen15901.h"
+#include "sen15901_hw_sim.h"
+#include "types.h"
+
+/*** SEN15901 BENCH local macros ***/
+
+#define SEN15901_BENCH_DAYS                     7
+#define SEN15901_BENCH_BLOCK_SECONDS            3600
+#define SEN15901_BENCH_TRACE_SIZE               (SEN15901_BENCH_DAYS * 86400)
+
+#define SEN15901_BENCH_WIND_SPEED_EDGES_MAX     30
+#define SEN15901_BENCH_RAIN_EDGES_MAX           3
+
+#define SEN15901_BENCH_WIND_DIRECTIONS_NUMBER   16
+#define SEN15901_BENCH_PI                       3.14159265358979323846
+
+// Tolerances of the integer driver against the double precision reference.
+#define SEN15901_BENCH_AVERAGE_SPEED_TOLERANCE_MH   1
+#define SEN15901_BENCH_DIRECTION_TOLERANCE_DEGREES  2
+
+/*** SEN15901 BENCH local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t resistor_ohms;
+    int32_t angle_degrees;
+} SEN15901_BENCH_wind_direction_t;
+
+/*******************************************************************/
+typedef struct {
+    double wind_speed_mh_sum;
+    int32_t peak_speed_mh;
+    double wind_direction_x;
+    double wind_direction_y;
+    uint32_t rain_edge_count;
+} SEN15901_BENCH_reference_t;
+
+/*** SEN15901 BENCH local global variables ***/
+
+// Vane resistors and matching directions (datasheet).
+static const SEN15901_BENCH_wind_direction_t SEN15901_BENCH_WIND_DIRECTION[SEN15901_BENCH_WIND_DIRECTIONS_NUMBER] = {
+    { 33000, 0 }, { 6570, 22 }, { 8200, 45 }, { 891, 67 }, { 1000, 90 }, { 688, 112 }, { 2200, 135 }, { 1410, 157 },
+    { 3900, 180 }, { 3140, 202 }, { 16000, 225 }, { 14120, 247 }, { 120000, 270 }, { 42120, 292 }, { 64900, 315 }, { 21880, 337 }
+};
+
+static SEN15901_HW_SIM_trace_second_t sen15901_bench_trace[SEN15901_BENCH_TRACE_SIZE];
+
+/*** SEN15901 BENCH local functions ***/
+
+/*******************************************************************/
+static uint32_t _SEN15901_BENCH_random(uint32_t* seed) {
+    // Portable linear congruential generator, so that the trace is the same on all hosts.
+    (*seed) = (((*seed) * 1664525) + 1013904223);
+    return ((*seed) >> 8);
+}
+
+/*******************************************************************/
+static void _SEN15901_BENCH_process_callback(SEN15901_context_t* context) {
+    // Process function is called by the simulator.
+    UNUSED(context);
+}
+
+/*******************************************************************/
+static void _SEN15901_BENCH_build_trace(SEN15901_BENCH_reference_t* reference) {
+    // Local variables.
+    uint32_t seed = 15901;
+    uint32_t block_idx = 0;
+    uint32_t second_idx = 0;
+    uint32_t wind_speed_edge_count = 0;
+    uint32_t rain_period_seconds = 0;
+    uint32_t rain_edge_count = 0;
+    uint32_t resistor_ohms = 0;
+    int32_t wind_speed_kmh = 0;
+    double angle_radians = 0.0;
+    uint8_t direction_idx = 0;
+    SEN15901_HW_SIM_trace_second_t* second = NULL;
+    // Constant conditions over each block, so that the reference does not depend on the sampling periods.
+    for (block_idx = 0; block_idx < (SEN15901_BENCH_TRACE_SIZE / SEN15901_BENCH_BLOCK_SECONDS); block_idx++) {
+        wind_speed_edge_count = (_SEN15901_BENCH_random(&seed) % (SEN15901_BENCH_WIND_SPEED_EDGES_MAX + 1));
+        direction_idx = (uint8_t) (_SEN15901_BENCH_random(&seed) % SEN15901_BENCH_WIND_DIRECTIONS_NUMBER);
+        rain_period_seconds = ((_SEN15901_BENCH_random(&seed) % 4) == 0) ? (5 + (_SEN15901_BENCH_random(&seed) % 56)) : 0;
+        rain_edge_count = (1 + (_SEN15901_BENCH_random(&seed) % SEN15901_BENCH_RAIN_EDGES_MAX));
+        resistor_ohms = SEN15901_BENCH_WIND_DIRECTION[direction_idx].resistor_ohms;
+        for (second_idx = 0; second_idx < SEN15901_BENCH_BLOCK_SECONDS; second_idx++) {
+            second = &(sen15901_bench_trace[(block_idx * SEN15901_BENCH_BLOCK_SECONDS) + second_idx]);
+            second->wind_speed_edge_count = (uint16_t) wind_speed_edge_count;
+            second->wind_direction_ratio_permille = (int16_t) ((1000 * resistor_ohms) / (resistor_ohms + SEN15901_DRIVER_WIND_DIRECTION_PULL_UP_RESISTOR_OHMS));
+            second->rain_edge_count = (uint16_t) (((rain_period_seconds != 0) && ((second_idx % rain_period_seconds) == 0)) ? rain_edge_count : 0);
+            reference->rain_edge_count += second->rain_edge_count;
+        }
+        // Update reference.
+        reference->wind_speed_mh_sum += ((double) (wind_speed_edge_count * 2400)) * SEN15901_BENCH_BLOCK_SECONDS;
+        if ((int32_t) (wind_speed_edge_count * 2400) > reference->peak_speed_mh) {
+            reference->peak_speed_mh = (int32_t) (wind_speed_edge_count * 2400);
+        }
+        wind_speed_kmh = (int32_t) ((wind_speed_edge_count * 2400) / 1000);
+        angle_radians = ((double) SEN15901_BENCH_WIND_DIRECTION[direction_idx].angle_degrees) * SEN15901_BENCH_PI / 180.0;
+        reference->wind_direction_x += ((double) wind_speed_kmh) * cos(angle_radians) * SEN15901_BENCH_BLOCK_SECONDS;
+        reference->wind_direction_y += ((double) wind_speed_kmh) * sin(angle_radians) * SEN15901_BENCH_BLOCK_SECONDS;
+    }
+}
+
+/*******************************************************************/
+static int32_t _SEN15901_BENCH_get_ns_per_op(uint64_t time_ns, uint32_t count) {
+    // Avoid division by zero.
+    return (count == 0) ? 0 : ((int32_t) (time_ns / count));
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_BENCH_check(const char* name, int32_t value, int32_t reference, int32_t tolerance) {
+    // Local variables.
+    uint8_t pass = (((value - reference) <= tolerance) && ((reference - value) <= tolerance)) ? 1 : 0;
+    // Print result.
+    printf("%-20s %10d (reference %10d) %s\n", name, (int) value, (int) reference, (pass != 0) ? "OK" : "FAILED");
+    return pass;
+}
+
+/*** SEN15901 BENCH main function ***/
+
+/*******************************************************************/
+int main(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_context_t context;
+    SEN15901_HW_SIM_statistics_t statistics = { 0 };
+    SEN15901_BENCH_reference_t reference = { 0.0, 0, 0.0, 0.0, 0 };
+    SEN15901_snapshot_t snapshot;
+    int32_t reference_direction_degrees = 0;
+    int32_t direction_error_degrees = 0;
+    uint8_t pass = 1;
+    // Build trace and reference values.
+    _SEN15901_BENCH_build_trace(&reference);
+    reference_direction_degrees = (int32_t) lround(atan2(reference.wind_direction_y, reference.wind_direction_x) * 180.0 / SEN15901_BENCH_PI);
+    reference_direction_degrees = ((reference_direction_degrees + 360) % 360);
+    // Replay trace.
+    status = SEN15901_instance_init(&context, 0, &_SEN15901_BENCH_process_callback);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_set_wind_measurement(&context, 1);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_set_rainfall_measurement(&context, 1);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_HW_SIM_replay(&context, sen15901_bench_trace, SEN15901_BENCH_TRACE_SIZE, &statistics);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_snapshot(&context, &snapshot);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_de_init(&context);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Print execution times.
+    printf("%d days replayed\n", SEN15901_BENCH_DAYS);
+    printf("tick                 %10u calls %6d ns/op\n", (unsigned int) statistics.tick_count, (int) _SEN15901_BENCH_get_ns_per_op(statistics.tick_time_ns, statistics.tick_count));
+    printf("edge                 %10u calls %6d ns/op\n", (unsigned int) statistics.edge_count, (int) _SEN15901_BENCH_get_ns_per_op(statistics.edge_time_ns, statistics.edge_count));
+    printf("direction sample     %10u calls %6d ns/op\n", (unsigned int) statistics.wind_direction_sample_count, (int) _SEN15901_BENCH_get_ns_per_op(statistics.wind_direction_time_ns, statistics.wind_direction_sample_count));
+    // Compare snapshot with reference values.
+    pass &= _SEN15901_BENCH_check("average speed (m/h)", snapshot.average_speed_mh, (int32_t) (reference.wind_speed_mh_sum / SEN15901_BENCH_TRACE_SIZE), SEN15901_BENCH_AVERAGE_SPEED_TOLERANCE_MH);
+    pass &= _SEN15901_BENCH_check("peak speed (m/h)", snapshot.peak_speed_mh, reference.peak_speed_mh, 0);
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+    pass &= _SEN15901_BENCH_check("gust speed (m/h)", snapshot.gust_speed_mh, reference.peak_speed_mh, 0);
+#endif
+    pass &= _SEN15901_BENCH_check("direction status", (int32_t) snapshot.direction_status, (int32_t) SEN15901_WIND_DIRECTION_STATUS_AVAILABLE, 0);
+    direction_error_degrees = (((snapshot.average_direction_degrees - reference_direction_degrees) + 540) % 360) - 180;
+    pass &= _SEN15901_BENCH_check("direction (degrees)", reference_direction_degrees + direction_error_degrees, reference_direction_degrees, SEN15901_BENCH_DIRECTION_TOLERANCE_DEGREES);
+    pass &= _SEN15901_BENCH_check("rain edges", (int32_t) statistics.rain_edge_count, (int32_t) reference.rain_edge_count, 0);
+    pass &= _SEN15901_BENCH_check("rainfall (um)", snapshot.rainfall_um, (int32_t) (reference.rain_edge_count * SEN15901_RAIN_EDGE_TO_UM), 0);
+    return (pass != 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+errors:
+    printf("SEN15901 driver error 0x%x\n", (unsigned int) status);
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,264 @@
+/*
+ * sen15901_bulk_test.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "maths.h"
+#include "sen15901.h"
+#include "sen15901_bulk.h"
+#include "sen15901_tables.h"
+#include "types.h"
+
+/*** SEN15901 BULK TEST local macros ***/
+
+// Odd number of samples, so that the scalar tails of the vector loops are used.
+#define SEN15901_BULK_TEST_SAMPLES_NUMBER       200003
+#define SEN15901_BULK_TEST_SEGMENT_SIZE         1000
+#define SEN15901_BULK_TEST_CHUNK_SIZE_MAX       300
+
+#define SEN15901_BULK_TEST_CALM_EDGES_MAX       60
+#define SEN15901_BULK_TEST_STORM_EDGES_MIN      1000
+#define SEN15901_BULK_TEST_STORM_EDGES_MAX      20000
+#define SEN15901_BULK_TEST_OVERFLOW_EDGES_MAX   2000000
+
+// Exit code of the skipped tests (CTest SKIP_RETURN_CODE).
+#define SEN15901_BULK_TEST_SKIPPED              77
+
+#if (defined __AVX2__)
+#define SEN15901_BULK_TEST_PATH                 "AVX2"
+#elif (defined __SSE2__)
+#define SEN15901_BULK_TEST_PATH                 "SSE2"
+#else
+#define SEN15901_BULK_TEST_PATH                 "scalar"
+#endif
+
+/*** SEN15901 BULK TEST local structures ***/
+
+/*******************************************************************/
+typedef struct {
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    int64_t trend_point_x;
+    int64_t trend_point_y;
+#else
+    int32_t trend_point_x;
+    int32_t trend_point_y;
+    uint8_t trend_point_shift;
+#endif
+} SEN15901_BULK_TEST_trend_t;
+
+/*** SEN15901 BULK TEST local global variables ***/
+
+static int32_t sen15901_bulk_test_ratio_permille[SEN15901_BULK_TEST_SAMPLES_NUMBER];
+static uint32_t sen15901_bulk_test_edge_count[SEN15901_BULK_TEST_SAMPLES_NUMBER];
+static uint8_t sen15901_bulk_test_index[SEN15901_BULK_TEST_SAMPLES_NUMBER];
+static int32_t sen15901_bulk_test_degrees[SEN15901_BULK_TEST_SAMPLES_NUMBER];
+static uint32_t sen15901_bulk_test_wind_speed_mh[SEN15901_BULK_TEST_SAMPLES_NUMBER];
+static int32_t sen15901_bulk_test_rainfall_um[SEN15901_BULK_TEST_SAMPLES_NUMBER];
+
+/*** SEN15901 BULK TEST local functions ***/
+
+/*******************************************************************/
+static uint32_t _SEN15901_BULK_TEST_random(uint32_t* seed) {
+    // Portable linear congruential generator, so that the samples are the same on all hosts.
+    (*seed) = (((*seed) * 1664525) + 1013904223);
+    return ((*seed) >> 8);
+}
+
+/*******************************************************************/
+static void _SEN15901_BULK_TEST_build_samples(void) {
+    // Local variables.
+    uint32_t seed = 21;
+    uint32_t idx = 0;
+    uint32_t segment_mode = 0;
+    int32_t segment_ratio_permille = 0;
+    // Segments of calm random samples, storms with a constant direction (trend point rescaling) and overflowing products.
+    for (idx = 0; idx < SEN15901_BULK_TEST_SAMPLES_NUMBER; idx++) {
+        if ((idx % SEN15901_BULK_TEST_SEGMENT_SIZE) == 0) {
+            segment_mode = (_SEN15901_BULK_TEST_random(&seed) % 4);
+            segment_ratio_permille = (int32_t) (_SEN15901_BULK_TEST_random(&seed) % (MATH_PERMILLE_MAX + 1));
+        }
+        switch (segment_mode) {
+        case 0:
+        case 1:
+            sen15901_bulk_test_ratio_permille[idx] = (int32_t) (_SEN15901_BULK_TEST_random(&seed) % (MATH_PERMILLE_MAX + 101)) - 50;
+            sen15901_bulk_test_edge_count[idx] = (_SEN15901_BULK_TEST_random(&seed) % SEN15901_BULK_TEST_CALM_EDGES_MAX);
+            break;
+        case 2:
+            sen15901_bulk_test_ratio_permille[idx] = segment_ratio_permille;
+            sen15901_bulk_test_edge_count[idx] = SEN15901_BULK_TEST_STORM_EDGES_MIN + (_SEN15901_BULK_TEST_random(&seed) % (SEN15901_BULK_TEST_STORM_EDGES_MAX - SEN15901_BULK_TEST_STORM_EDGES_MIN));
+            break;
+        default:
+            sen15901_bulk_test_ratio_permille[idx] = (int32_t) (_SEN15901_BULK_TEST_random(&seed) % (MATH_PERMILLE_MAX + 1));
+            sen15901_bulk_test_edge_count[idx] = (_SEN15901_BULK_TEST_random(&seed) % SEN15901_BULK_TEST_OVERFLOW_EDGES_MAX);
+            break;
+        }
+    }
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_BULK_TEST_get_index(int32_t wind_direction_ratio_permille) {
+    // Local variables.
+    uint8_t idx_low = 0;
+    uint8_t idx_high = (SEN15901_WIND_DIRECTIONS_NUMBER - 1);
+    uint8_t idx_middle = 0;
+    // Driver binary search.
+    if (wind_direction_ratio_permille > MATH_PERMILLE_MAX) {
+        return SEN15901_BULK_WIND_DIRECTION_INDEX_ERROR;
+    }
+    while (idx_low < idx_high) {
+        idx_middle = ((idx_low + idx_high) >> 1);
+        if (wind_direction_ratio_permille <= SEN15901_WIND_DIRECTION_RATIO_THRESHOLD[idx_middle]) {
+            idx_high = idx_middle;
+        }
+        else {
+            idx_low = (idx_middle + 1);
+        }
+    }
+    return idx_low;
+}
+
+/*******************************************************************/
+static void _SEN15901_BULK_TEST_add_vector(SEN15901_BULK_TEST_trend_t* trend, uint32_t wind_speed_mh, uint8_t wind_direction_index) {
+    // Local variables.
+    uint32_t wind_direction_degrees = SEN15901_WIND_DIRECTION_ANGLE_DEGREES[wind_direction_index];
+    // Driver 32-bit products (wrapped).
+    int32_t vector_x = (int32_t) ((wind_speed_mh / 1000) * ((uint32_t) ((int32_t) MATH_COS_TABLE[wind_direction_degrees])));
+    int32_t vector_y = (int32_t) ((wind_speed_mh / 1000) * ((uint32_t) ((int32_t) MATH_SIN_TABLE[wind_direction_degrees])));
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    trend->trend_point_x += (int64_t) vector_x;
+    trend->trend_point_y += (int64_t) vector_y;
+#else
+    // Driver sequence: add with the current scale, then halve before reaching overflow.
+    trend->trend_point_x += (vector_x >> (trend->trend_point_shift));
+    trend->trend_point_y += (vector_y >> (trend->trend_point_shift));
+    if ((trend->trend_point_x > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (trend->trend_point_x < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT)) ||
+        (trend->trend_point_y > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (trend->trend_point_y < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT))) {
+        trend->trend_point_x >>= 1;
+        trend->trend_point_y >>= 1;
+        trend->trend_point_shift++;
+    }
+#endif
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_BULK_TEST_compare_trend(SEN15901_BULK_TEST_trend_t* reference, SEN15901_BULK_trend_t* trend) {
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    return (((reference->trend_point_x) == (trend->trend_point_x)) && ((reference->trend_point_y) == (trend->trend_point_y))) ? 1 : 0;
+#else
+    return (((reference->trend_point_x) == (trend->trend_point_x)) && ((reference->trend_point_y) == (trend->trend_point_y)) && ((reference->trend_point_shift) == (trend->trend_point_shift))) ? 1 : 0;
+#endif
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_BULK_TEST_check(const char* name, uint32_t value, uint32_t reference) {
+    // Local variables.
+    uint8_t pass = (value == reference) ? 1 : 0;
+    // Print result.
+    printf("%-32s %10u (reference %10u) %s\n", name, (unsigned int) value, (unsigned int) reference, (pass != 0) ? "OK" : "FAILED");
+    return pass;
+}
+
+/*** SEN15901 BULK TEST main function ***/
+
+/*******************************************************************/
+int main(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    MATH_status_t math_status = MATH_SUCCESS;
+    SEN15901_BULK_trend_t trend;
+    SEN15901_BULK_TEST_trend_t reference_trend = { 0 };
+    SEN15901_wind_direction_status_t direction_status = SEN15901_WIND_DIRECTION_STATUS_UNDEFINED;
+    int32_t average_direction_degrees = 0;
+    int32_t reference_direction_degrees = 0;
+    int32_t reference_degrees = 0;
+    uint32_t seed = 2024;
+    uint32_t errors_count = 0;
+    uint32_t chunk_size = 0;
+    uint32_t chunks_count = 0;
+    uint32_t trend_errors_count = 0;
+    uint32_t idx = 0;
+    uint32_t chunk_idx = 0;
+    uint8_t reference_index = 0;
+    uint8_t pass = 1;
+#if ((defined __AVX2__) && (defined __GNUC__))
+    // Vector instructions of the build host may not be available on the test host.
+    if (__builtin_cpu_supports("avx2") == 0) {
+        printf("AVX2 is not supported by this CPU, test skipped\n");
+        return SEN15901_BULK_TEST_SKIPPED;
+    }
+#endif
+    printf("%s path\n", SEN15901_BULK_TEST_PATH);
+    _SEN15901_BULK_TEST_build_samples();
+    // Conversions.
+    status = SEN15901_BULK_get_wind_direction(sen15901_bulk_test_ratio_permille, sen15901_bulk_test_index, sen15901_bulk_test_degrees, SEN15901_BULK_TEST_SAMPLES_NUMBER);
+    pass &= _SEN15901_BULK_TEST_check("out of range ratio status", (uint32_t) status, (uint32_t) SEN15901_ERROR_RESISTOR_DIVIDER_RATIO);
+    for (idx = 0; idx < SEN15901_BULK_TEST_SAMPLES_NUMBER; idx++) {
+        reference_index = _SEN15901_BULK_TEST_get_index(sen15901_bulk_test_ratio_permille[idx]);
+        reference_degrees = (reference_index == SEN15901_BULK_WIND_DIRECTION_INDEX_ERROR) ? SEN15901_BULK_WIND_DIRECTION_DEGREES_ERROR : ((int32_t) SEN15901_WIND_DIRECTION_ANGLE_DEGREES[reference_index]);
+        if ((sen15901_bulk_test_index[idx] != reference_index) || (sen15901_bulk_test_degrees[idx] != reference_degrees)) {
+            errors_count++;
+        }
+    }
+    pass &= _SEN15901_BULK_TEST_check("wind direction errors", errors_count, 0);
+    status = SEN15901_BULK_get_wind_speed(sen15901_bulk_test_edge_count, sen15901_bulk_test_wind_speed_mh, SEN15901_BULK_TEST_SAMPLES_NUMBER);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_BULK_get_rainfall(sen15901_bulk_test_edge_count, sen15901_bulk_test_rainfall_um, SEN15901_BULK_TEST_SAMPLES_NUMBER);
+    if (status != SEN15901_SUCCESS) goto errors;
+    errors_count = 0;
+    for (idx = 0; idx < SEN15901_BULK_TEST_SAMPLES_NUMBER; idx++) {
+        if ((sen15901_bulk_test_wind_speed_mh[idx] != ((sen15901_bulk_test_edge_count[idx] * SEN15901_WIND_SPEED_1HZ_TO_MH) / SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS)) ||
+            (sen15901_bulk_test_rainfall_um[idx] != ((int32_t) (sen15901_bulk_test_edge_count[idx] * SEN15901_RAIN_EDGE_TO_UM)))) {
+            errors_count++;
+        }
+    }
+    pass &= _SEN15901_BULK_TEST_check("wind speed and rainfall errors", errors_count, 0);
+    // Trend point compared after each chunk of random size.
+    status = SEN15901_BULK_trend_init(&trend);
+    if (status != SEN15901_SUCCESS) goto errors;
+    for (idx = 0; idx < SEN15901_BULK_TEST_SAMPLES_NUMBER; idx += chunk_size) {
+        chunk_size = (1 + (_SEN15901_BULK_TEST_random(&seed) % SEN15901_BULK_TEST_CHUNK_SIZE_MAX));
+        if ((idx + chunk_size) > SEN15901_BULK_TEST_SAMPLES_NUMBER) {
+            chunk_size = (SEN15901_BULK_TEST_SAMPLES_NUMBER - idx);
+        }
+        status = SEN15901_BULK_trend_add(&trend, &(sen15901_bulk_test_wind_speed_mh[idx]), &(sen15901_bulk_test_index[idx]), chunk_size);
+        if (status != SEN15901_SUCCESS) goto errors;
+        for (chunk_idx = idx; chunk_idx < (idx + chunk_size); chunk_idx++) {
+            if (sen15901_bulk_test_index[chunk_idx] == SEN15901_BULK_WIND_DIRECTION_INDEX_ERROR) continue;
+            _SEN15901_BULK_TEST_add_vector(&reference_trend, sen15901_bulk_test_wind_speed_mh[chunk_idx], sen15901_bulk_test_index[chunk_idx]);
+        }
+        trend_errors_count += (_SEN15901_BULK_TEST_compare_trend(&reference_trend, &trend) != 0) ? 0 : 1;
+        chunks_count++;
+    }
+    printf("%u chunks added\n", (unsigned int) chunks_count);
+    pass &= _SEN15901_BULK_TEST_check("trend point errors", trend_errors_count, 0);
+#ifndef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    // Storms must have rescaled the trend point within blocks (replay of the driver sequence).
+    pass &= _SEN15901_BULK_TEST_check("trend point rescaled", (reference_trend.trend_point_shift > 0) ? 1 : 0, 1);
+#endif
+    // Average direction.
+    status = SEN15901_BULK_trend_get_direction(&trend, &average_direction_degrees, &direction_status);
+    if (status != SEN15901_SUCCESS) goto errors;
+#ifdef SEN15901_DRIVER_WIND_DIRECTION_TREND_64_BITS
+    while ((reference_trend.trend_point_x > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (reference_trend.trend_point_x < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT)) ||
+           (reference_trend.trend_point_y > SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT) || (reference_trend.trend_point_y < (-SEN15901_WIND_DIRECTION_TREND_POINT_LIMIT))) {
+        reference_trend.trend_point_x >>= 1;
+        reference_trend.trend_point_y >>= 1;
+    }
+#endif
+    math_status = MATH_atan2((int32_t) reference_trend.trend_point_x, (int32_t) reference_trend.trend_point_y, &reference_direction_degrees);
+    if (math_status != MATH_SUCCESS) {
+        printf("MATH error 0x%x\n", (unsigned int) math_status);
+        return EXIT_FAILURE;
+    }
+    pass &= _SEN15901_BULK_TEST_check("direction status", (uint32_t) direction_status, (uint32_t) SEN15901_WIND_DIRECTION_STATUS_AVAILABLE);
+    pass &= _SEN15901_BULK_TEST_check("direction (degrees)", (uint32_t) average_direction_degrees, (uint32_t) reference_direction_degrees);
+    return (pass != 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+errors:
+    printf("SEN15901 driver error 0x%x\n", (unsigned int) status);
+    return EXIT_FAILURE;
+}
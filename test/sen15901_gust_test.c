@@ -0,0 +1,115 @@
+/*
+ * sen15901_gust_test.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sen15901.h"
+#include "sen15901_hw_sim.h"
+#include "types.h"
+
+/*** SEN15901 GUST TEST local macros ***/
+
+#define SEN15901_GUST_TEST_SECONDS_MAX          60
+
+// Anemometer edges per gust sample.
+#define SEN15901_GUST_TEST_CALM_SAMPLE_EDGES    1
+#define SEN15901_GUST_TEST_GUST_SAMPLE_EDGES    12
+
+#define SEN15901_GUST_TEST_EDGES(sample_edges)  ((sample_edges) * SEN15901_DRIVER_WIND_GUST_SAMPLES_PER_SECOND)
+#define SEN15901_GUST_TEST_SPEED_MH(edge_sum)   (((edge_sum) * 2400) / SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS)
+
+/*** SEN15901 GUST TEST local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    const char* name;
+    uint32_t seconds;
+    uint16_t wind_speed_edge_count;
+    uint32_t gust_speed_mh;
+} SEN15901_GUST_TEST_phase_t;
+
+/*** SEN15901 GUST TEST local global variables ***/
+
+// Each phase is closed by a snapshot, the gust ends with the interval and the first window of the next one still holds its samples but one.
+static const SEN15901_GUST_TEST_phase_t SEN15901_GUST_TEST_PHASES[] = {
+    { "calm", 60, SEN15901_GUST_TEST_EDGES(SEN15901_GUST_TEST_CALM_SAMPLE_EDGES), SEN15901_GUST_TEST_SPEED_MH(SEN15901_GUST_TEST_CALM_SAMPLE_EDGES * SEN15901_WIND_GUST_SAMPLES_NUMBER) },
+    { "gust", SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS, SEN15901_GUST_TEST_EDGES(SEN15901_GUST_TEST_GUST_SAMPLE_EDGES), SEN15901_GUST_TEST_SPEED_MH(SEN15901_GUST_TEST_GUST_SAMPLE_EDGES * SEN15901_WIND_GUST_SAMPLES_NUMBER) },
+    { "after gust", 60, SEN15901_GUST_TEST_EDGES(SEN15901_GUST_TEST_CALM_SAMPLE_EDGES), SEN15901_GUST_TEST_SPEED_MH((SEN15901_GUST_TEST_GUST_SAMPLE_EDGES * (SEN15901_WIND_GUST_SAMPLES_NUMBER - 1)) + SEN15901_GUST_TEST_CALM_SAMPLE_EDGES) },
+    { "calm", 60, SEN15901_GUST_TEST_EDGES(SEN15901_GUST_TEST_CALM_SAMPLE_EDGES), SEN15901_GUST_TEST_SPEED_MH(SEN15901_GUST_TEST_CALM_SAMPLE_EDGES * SEN15901_WIND_GUST_SAMPLES_NUMBER) },
+};
+
+static SEN15901_HW_SIM_trace_second_t sen15901_gust_test_trace[SEN15901_GUST_TEST_SECONDS_MAX];
+
+/*** SEN15901 GUST TEST local functions ***/
+
+/*******************************************************************/
+static void _SEN15901_GUST_TEST_process_callback(SEN15901_context_t* context) {
+    // Process function is called by the simulator.
+    UNUSED(context);
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_GUST_TEST_check(const char* name, uint32_t value, uint32_t reference) {
+    // Local variables.
+    uint8_t pass = (value == reference) ? 1 : 0;
+    // Print result.
+    printf("%-32s %6u (reference %6u) %s\n", name, (unsigned int) value, (unsigned int) reference, (pass != 0) ? "OK" : "FAILED");
+    return pass;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_GUST_TEST_run_phase(SEN15901_context_t* context, const SEN15901_GUST_TEST_phase_t* phase, uint8_t* pass) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_statistics_t statistics = { 0 };
+    SEN15901_snapshot_t snapshot;
+    char name[32];
+    uint32_t idx = 0;
+    // Constant anemometer frequency.
+    for (idx = 0; idx < phase->seconds; idx++) {
+        sen15901_gust_test_trace[idx].wind_speed_edge_count = phase->wind_speed_edge_count;
+        sen15901_gust_test_trace[idx].rain_edge_count = 0;
+        sen15901_gust_test_trace[idx].wind_direction_ratio_permille = 500;
+    }
+    status = SEN15901_HW_SIM_replay(context, sen15901_gust_test_trace, phase->seconds, &statistics);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_snapshot(context, &snapshot);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Check gust.
+    snprintf(name, sizeof(name), "%s gust speed (m/h)", phase->name);
+    (*pass) &= _SEN15901_GUST_TEST_check(name, (uint32_t) snapshot.gust_speed_mh, phase->gust_speed_mh);
+errors:
+    return status;
+}
+
+/*** SEN15901 GUST TEST main function ***/
+
+/*******************************************************************/
+int main(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_context_t context;
+    uint8_t phase_idx = 0;
+    uint8_t pass = 1;
+    // Init instance and start wind measurement.
+    status = SEN15901_instance_init(&context, 0, &_SEN15901_GUST_TEST_process_callback);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_set_wind_measurement(&context, 1);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Gust at the end of an interval.
+    for (phase_idx = 0; phase_idx < (sizeof(SEN15901_GUST_TEST_PHASES) / sizeof(SEN15901_GUST_TEST_phase_t)); phase_idx++) {
+        status = _SEN15901_GUST_TEST_run_phase(&context, &(SEN15901_GUST_TEST_PHASES[phase_idx]), &pass);
+        if (status != SEN15901_SUCCESS) goto errors;
+    }
+    status = SEN15901_instance_de_init(&context);
+    if (status != SEN15901_SUCCESS) goto errors;
+    return (pass != 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+errors:
+    printf("SEN15901 driver error 0x%x\n", (unsigned int) status);
+    return EXIT_FAILURE;
+}
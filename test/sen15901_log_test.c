@@ -0,0 +1,298 @@
+/*
+ * sen15901_log_test.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sen15901.h"
+#include "sen15901_log.h"
+#include "sen15901_log_hw.h"
+#include "types.h"
+
+/*** SEN15901 LOG TEST local macros ***/
+
+#define SEN15901_LOG_TEST_RECORDS_NUMBER    1440
+#define SEN15901_LOG_TEST_BUFFER_SIZE       (40 * SEN15901_DRIVER_LOG_BLOCK_SIZE)
+
+/*** SEN15901 LOG TEST local global variables ***/
+
+static SEN15901_LOG_record_t sen15901_log_test_records[SEN15901_LOG_TEST_RECORDS_NUMBER];
+static uint8_t sen15901_log_test_buffer[SEN15901_LOG_TEST_BUFFER_SIZE];
+
+/*** SEN15901 LOG TEST local functions ***/
+
+/*******************************************************************/
+static uint32_t _SEN15901_LOG_TEST_random(uint32_t* seed) {
+    // Portable linear congruential generator, so that the records are the same on all hosts.
+    (*seed) = (((*seed) * 1664525) + 1013904223);
+    return ((*seed) >> 8);
+}
+
+/*******************************************************************/
+static void _SEN15901_LOG_TEST_build_records(void) {
+    // Local variables.
+    uint32_t seed = 17;
+    uint32_t record_idx = 0;
+    int32_t average_speed_mh = 10000;
+    uint8_t direction_sector = 3;
+    SEN15901_LOG_record_t* record = NULL;
+    // Random walk of the speed with a few rain tips.
+    for (record_idx = 0; record_idx < SEN15901_LOG_TEST_RECORDS_NUMBER; record_idx++) {
+        average_speed_mh += (int32_t) (_SEN15901_LOG_TEST_random(&seed) % 1001) - 500;
+        if (average_speed_mh < 0) {
+            average_speed_mh = 0;
+        }
+        if ((_SEN15901_LOG_TEST_random(&seed) % 10) == 0) {
+            direction_sector = (uint8_t) ((direction_sector + 1) % (SEN15901_LOG_DIRECTION_SECTOR_UNDEFINED + 1));
+        }
+        record = &(sen15901_log_test_records[record_idx]);
+        record->index = 0;
+        record->average_speed_mh = average_speed_mh;
+        record->gust_speed_mh = average_speed_mh + (int32_t) (_SEN15901_LOG_TEST_random(&seed) % 3000);
+        record->direction_sector = direction_sector;
+        record->rain_edge_count = ((_SEN15901_LOG_TEST_random(&seed) % 20) == 0) ? (_SEN15901_LOG_TEST_random(&seed) % 10) : 0;
+    }
+}
+
+/*******************************************************************/
+static int32_t _SEN15901_LOG_TEST_quantize(int32_t speed_mh) {
+    return (((speed_mh + (SEN15901_LOG_WIND_SPEED_RESOLUTION_MH / 2)) / SEN15901_LOG_WIND_SPEED_RESOLUTION_MH) * SEN15901_LOG_WIND_SPEED_RESOLUTION_MH);
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_LOG_TEST_append(SEN15901_LOG_context_t* log, uint32_t first_record, uint32_t records_count) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t record_idx = 0;
+    // Append records.
+    for (record_idx = first_record; record_idx < (first_record + records_count); record_idx++) {
+        status = SEN15901_LOG_append(log, &(sen15901_log_test_records[record_idx]));
+        if (status != SEN15901_SUCCESS) goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_LOG_TEST_drain(SEN15901_LOG_context_t* log, uint32_t* first_index, uint32_t* records_count, uint8_t* pass) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_LOG_iterator_t iterator;
+    SEN15901_LOG_record_t record;
+    SEN15901_LOG_record_t* reference = NULL;
+    const uint8_t* chunk = NULL;
+    uint32_t chunk_size = 0;
+    uint8_t record_available = 0;
+    // Read all closed blocks.
+    (*records_count) = 0;
+    status = SEN15901_LOG_flush(log);
+    if (status != SEN15901_SUCCESS) goto errors;
+    while (1) {
+        status = SEN15901_LOG_read(log, &chunk, &chunk_size);
+        if (status != SEN15901_SUCCESS) goto errors;
+        if (chunk_size == 0) break;
+        status = SEN15901_LOG_iterator_init(&iterator, chunk, chunk_size);
+        if (status != SEN15901_SUCCESS) goto errors;
+        while (1) {
+            status = SEN15901_LOG_iterator_next(&iterator, &record, &record_available);
+            if (status != SEN15901_SUCCESS) goto errors;
+            if (record_available == 0) break;
+            // Records must be consecutive and match the appended ones.
+            if ((*records_count) == 0) {
+                (*first_index) = record.index;
+            }
+            reference = &(sen15901_log_test_records[record.index % SEN15901_LOG_TEST_RECORDS_NUMBER]);
+            if ((record.index != ((*first_index) + (*records_count))) ||
+                (record.average_speed_mh != _SEN15901_LOG_TEST_quantize(reference->average_speed_mh)) ||
+                (record.gust_speed_mh != _SEN15901_LOG_TEST_quantize(reference->gust_speed_mh)) ||
+                (record.direction_sector != reference->direction_sector) ||
+                (record.rain_edge_count != reference->rain_edge_count)) {
+                (*pass) = 0;
+            }
+            (*records_count)++;
+        }
+        status = SEN15901_LOG_release(log);
+        if (status != SEN15901_SUCCESS) goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_LOG_TEST_check(const char* name, uint32_t value, uint32_t reference, uint8_t pass) {
+    // Update result.
+    if (value != reference) {
+        pass = 0;
+    }
+    // Print result.
+    printf("%-32s %6u (reference %6u) %s\n", name, (unsigned int) value, (unsigned int) reference, (pass != 0) ? "OK" : "FAILED");
+    return pass;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_LOG_TEST_round_trip(uint8_t* pass) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_LOG_context_t log;
+    uint32_t first_index = 0;
+    uint32_t records_count = 0;
+    uint32_t lost_count = 0;
+    uint8_t records_pass = 1;
+    // All records, the oldest blocks are dropped.
+    status = SEN15901_LOG_init(&log, sen15901_log_test_buffer, SEN15901_LOG_TEST_BUFFER_SIZE);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = _SEN15901_LOG_TEST_append(&log, 0, SEN15901_LOG_TEST_RECORDS_NUMBER);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_LOG_get_lost_count(&log, &lost_count);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = _SEN15901_LOG_TEST_drain(&log, &first_index, &records_count, &records_pass);
+    if (status != SEN15901_SUCCESS) goto errors;
+    (*pass) &= _SEN15901_LOG_TEST_check("round trip records", (records_count + lost_count), SEN15901_LOG_TEST_RECORDS_NUMBER, records_pass);
+    (*pass) &= _SEN15901_LOG_TEST_check("round trip first index", first_index, lost_count, 1);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_LOG_TEST_recover(uint8_t* pass) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_LOG_context_t log;
+    SEN15901_LOG_iterator_t iterator;
+    SEN15901_LOG_record_t record;
+    const uint8_t* chunk = NULL;
+    uint32_t chunk_size = 0;
+    uint32_t first_index = 0;
+    uint32_t records_count = 0;
+    uint32_t released_count = 0;
+    uint8_t record_available = 0;
+    uint8_t records_pass = 1;
+    // Reset with some blocks already released.
+    status = SEN15901_LOG_init(&log, sen15901_log_test_buffer, SEN15901_LOG_TEST_BUFFER_SIZE);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = _SEN15901_LOG_TEST_append(&log, 0, 200);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_LOG_read(&log, &chunk, &chunk_size);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_LOG_iterator_init(&iterator, chunk, chunk_size);
+    if (status != SEN15901_SUCCESS) goto errors;
+    while (1) {
+        status = SEN15901_LOG_iterator_next(&iterator, &record, &record_available);
+        if (status != SEN15901_SUCCESS) goto errors;
+        if (record_available == 0) break;
+        released_count++;
+    }
+    status = SEN15901_LOG_release(&log);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_LOG_recover(&log, sen15901_log_test_buffer, SEN15901_LOG_TEST_BUFFER_SIZE);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Appended records follow the recovered ones.
+    (*pass) &= _SEN15901_LOG_TEST_check("recovered next index", log.record_index, 200, 1);
+    status = _SEN15901_LOG_TEST_append(&log, 200, 100);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = _SEN15901_LOG_TEST_drain(&log, &first_index, &records_count, &records_pass);
+    if (status != SEN15901_SUCCESS) goto errors;
+    (*pass) &= _SEN15901_LOG_TEST_check("recovered first index", first_index, released_count, 1);
+    (*pass) &= _SEN15901_LOG_TEST_check("recovered records", records_count, (300 - released_count), records_pass);
+    // Reset after the ring wrapped around the buffer.
+    status = SEN15901_LOG_init(&log, sen15901_log_test_buffer, SEN15901_LOG_TEST_BUFFER_SIZE);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = _SEN15901_LOG_TEST_append(&log, 0, SEN15901_LOG_TEST_RECORDS_NUMBER);
+    if (status != SEN15901_SUCCESS) goto errors;
+    released_count = log.lost_count;
+    status = SEN15901_LOG_recover(&log, sen15901_log_test_buffer, SEN15901_LOG_TEST_BUFFER_SIZE);
+    if (status != SEN15901_SUCCESS) goto errors;
+    records_pass = 1;
+    status = _SEN15901_LOG_TEST_drain(&log, &first_index, &records_count, &records_pass);
+    if (status != SEN15901_SUCCESS) goto errors;
+    (*pass) &= _SEN15901_LOG_TEST_check("recovered ring first index", first_index, released_count, 1);
+    (*pass) &= _SEN15901_LOG_TEST_check("recovered ring records", records_count, (SEN15901_LOG_TEST_RECORDS_NUMBER - released_count), records_pass);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_LOG_TEST_truncate(uint8_t* pass) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_LOG_context_t log;
+    uint32_t first_index = 0;
+    uint32_t records_count = 0;
+    uint32_t record_offset = 0;
+    uint32_t record_size = 0;
+    uint32_t last_record = 0;
+    uint32_t truncated_size = 0;
+    uint32_t truncated_count = 0;
+    uint32_t failed_count = 0;
+    uint32_t idx = 0;
+    uint8_t records_pass = 1;
+    // Last record is a delta record written after another record of the same block.
+    status = SEN15901_LOG_init(&log, sen15901_log_test_buffer, SEN15901_LOG_TEST_BUFFER_SIZE);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = _SEN15901_LOG_TEST_append(&log, 0, 100);
+    if (status != SEN15901_SUCCESS) goto errors;
+    for (last_record = 100; ; last_record++) {
+        record_offset = log.write_offset;
+        status = _SEN15901_LOG_TEST_append(&log, last_record, 1);
+        if (status != SEN15901_SUCCESS) goto errors;
+        if (log.write_offset > record_offset) break;
+    }
+    // Reset while each byte of the last record is written.
+    for (truncated_size = 0; ; truncated_size++) {
+        status = SEN15901_LOG_init(&log, sen15901_log_test_buffer, SEN15901_LOG_TEST_BUFFER_SIZE);
+        if (status != SEN15901_SUCCESS) goto errors;
+        status = _SEN15901_LOG_TEST_append(&log, 0, last_record);
+        if (status != SEN15901_SUCCESS) goto errors;
+        record_offset = log.write_offset;
+        status = _SEN15901_LOG_TEST_append(&log, last_record, 1);
+        if (status != SEN15901_SUCCESS) goto errors;
+        record_size = (log.write_offset - record_offset);
+        if (truncated_size >= record_size) break;
+        // Header already updated, end of the record still erased.
+        for (idx = truncated_size; idx < record_size; idx++) {
+            sen15901_log_test_buffer[((log.head % log.blocks_number) * SEN15901_DRIVER_LOG_BLOCK_SIZE) + record_offset + idx] = SEN15901_LOG_HW_ERASED_BYTE;
+        }
+        status = SEN15901_LOG_recover(&log, sen15901_log_test_buffer, SEN15901_LOG_TEST_BUFFER_SIZE);
+        if (status != SEN15901_SUCCESS) goto errors;
+        // Truncated record is dropped and its index is given to the next one.
+        status = _SEN15901_LOG_TEST_append(&log, last_record, 1);
+        if (status != SEN15901_SUCCESS) goto errors;
+        records_pass = 1;
+        status = _SEN15901_LOG_TEST_drain(&log, &first_index, &records_count, &records_pass);
+        if (status != SEN15901_SUCCESS) goto errors;
+        if ((records_pass == 0) || (first_index != 0) || (records_count != (last_record + 1))) {
+            failed_count++;
+        }
+        truncated_count++;
+    }
+    (*pass) &= _SEN15901_LOG_TEST_check("truncated record cases", truncated_count, record_size, 1);
+    (*pass) &= _SEN15901_LOG_TEST_check("truncated record failures", failed_count, 0, 1);
+errors:
+    return status;
+}
+
+/*** SEN15901 LOG TEST main function ***/
+
+/*******************************************************************/
+int main(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint8_t pass = 1;
+    // Build records.
+    _SEN15901_LOG_TEST_build_records();
+    // Run tests.
+    status = _SEN15901_LOG_TEST_round_trip(&pass);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = _SEN15901_LOG_TEST_recover(&pass);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = _SEN15901_LOG_TEST_truncate(&pass);
+    if (status != SEN15901_SUCCESS) goto errors;
+    return (pass != 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+errors:
+    printf("SEN15901 driver error 0x%x\n", (unsigned int) status);
+    return EXIT_FAILURE;
+}
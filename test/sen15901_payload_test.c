@@ -0,0 +1,247 @@
+/*
+ * sen15901_payload_test.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sen15901.h"
+#include "sen15901_payload.h"
+#include "types.h"
+
+/*** SEN15901 PAYLOAD TEST local macros ***/
+
+#define SEN15901_PAYLOAD_TEST_VALUE_MAX         ((int64_t) 0x7FFFFFFF)
+#define SEN15901_PAYLOAD_TEST_VALUE_MIN         (-SEN15901_PAYLOAD_TEST_VALUE_MAX - 1)
+#define SEN15901_PAYLOAD_TEST_VALUES_NUMBER     15
+#define SEN15901_PAYLOAD_TEST_PADDING_BYTE      0xA5
+
+#define SEN15901_PAYLOAD_TEST_DIRECTION_SECTORS_NUMBER  (1 << SEN15901_DRIVER_PAYLOAD_WIND_DIRECTION_BITS)
+
+/*** SEN15901 PAYLOAD TEST local functions ***/
+
+/*******************************************************************/
+static int32_t _SEN15901_PAYLOAD_TEST_clamp(int64_t value) {
+    // Inputs are snapshot integers.
+    if (value > SEN15901_PAYLOAD_TEST_VALUE_MAX) {
+        value = SEN15901_PAYLOAD_TEST_VALUE_MAX;
+    }
+    if (value < SEN15901_PAYLOAD_TEST_VALUE_MIN) {
+        value = SEN15901_PAYLOAD_TEST_VALUE_MIN;
+    }
+    return (int32_t) value;
+}
+
+/*******************************************************************/
+static int32_t _SEN15901_PAYLOAD_TEST_get_value(uint8_t value_idx, uint32_t resolution, uint8_t bits) {
+    // Local variables.
+    int64_t field_max_value = (int64_t) ((((uint64_t) 1) << bits) - 1) * (int64_t) resolution;
+    int64_t value = 0;
+    // Zero, negative values, rounding boundaries, field extremes and saturation.
+    switch (value_idx) {
+    case 0:
+        value = 0;
+        break;
+    case 1:
+        value = -1;
+        break;
+    case 2:
+        value = SEN15901_PAYLOAD_TEST_VALUE_MIN;
+        break;
+    case 3:
+        value = 1;
+        break;
+    case 4:
+        value = (int64_t) ((resolution - 1) / 2);
+        break;
+    case 5:
+        value = (int64_t) ((resolution + 1) / 2);
+        break;
+    case 6:
+        value = (int64_t) resolution;
+        break;
+    case 7:
+        value = (int64_t) (resolution + (resolution / 2));
+        break;
+    case 8:
+        value = field_max_value - (int64_t) resolution;
+        break;
+    case 9:
+        value = field_max_value - (int64_t) ((resolution + 1) / 2);
+        break;
+    case 10:
+        value = field_max_value;
+        break;
+    case 11:
+        value = field_max_value + (int64_t) ((resolution - 1) / 2);
+        break;
+    case 12:
+        value = field_max_value + (int64_t) resolution;
+        break;
+    case 13:
+        value = (2 * field_max_value);
+        break;
+    default:
+        value = SEN15901_PAYLOAD_TEST_VALUE_MAX;
+        break;
+    }
+    return _SEN15901_PAYLOAD_TEST_clamp(value);
+}
+
+/*******************************************************************/
+static int32_t _SEN15901_PAYLOAD_TEST_get_expected(int32_t value, uint32_t resolution, uint8_t bits) {
+    // Local variables.
+    uint64_t field_max = ((((uint64_t) 1) << bits) - 1);
+    uint64_t field = 0;
+    // Rounded to the resolution, saturated to the field width and to the snapshot integers.
+    if (value > 0) {
+        field = (((uint64_t) value) + (resolution / 2)) / resolution;
+    }
+    if (field > field_max) {
+        field = field_max;
+    }
+    return _SEN15901_PAYLOAD_TEST_clamp((int64_t) (field * resolution));
+}
+
+/*******************************************************************/
+static int32_t _SEN15901_PAYLOAD_TEST_get_maximum(uint32_t resolution, uint8_t bits) {
+    // Field maximum saturated to the snapshot integers.
+    return _SEN15901_PAYLOAD_TEST_clamp((int64_t) (((((uint64_t) 1) << bits) - 1) * resolution));
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_PAYLOAD_TEST_check(const char* name, uint32_t value, uint32_t reference) {
+    // Local variables.
+    uint8_t pass = (value == reference) ? 1 : 0;
+    // Print result.
+    printf("%-32s %6u (reference %6u) %s\n", name, (unsigned int) value, (unsigned int) reference, (pass != 0) ? "OK" : "FAILED");
+    return pass;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_PAYLOAD_TEST_round_trip(SEN15901_snapshot_t* snapshot, SEN15901_snapshot_t* decoded_snapshot) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint8_t payload[SEN15901_PAYLOAD_SIZE_BYTES + 1];
+    // Padding byte must not be written.
+    memset(payload, SEN15901_PAYLOAD_TEST_PADDING_BYTE, sizeof(payload));
+    status = SEN15901_PAYLOAD_encode(snapshot, payload, SEN15901_PAYLOAD_SIZE_BYTES);
+    if (status != SEN15901_SUCCESS) goto errors;
+    if (payload[SEN15901_PAYLOAD_SIZE_BYTES] != SEN15901_PAYLOAD_TEST_PADDING_BYTE) {
+        status = SEN15901_ERROR_PAYLOAD_SIZE;
+        goto errors;
+    }
+    memset(decoded_snapshot, 0, sizeof(SEN15901_snapshot_t));
+    status = SEN15901_PAYLOAD_decode(payload, SEN15901_PAYLOAD_SIZE_BYTES, decoded_snapshot);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_PAYLOAD_TEST_fields(uint8_t* pass) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_snapshot_t snapshot;
+    SEN15901_snapshot_t decoded_snapshot;
+    int32_t decoded_gust_speed_mh = 0;
+    uint32_t failed_count = 0;
+    uint8_t average_idx = 0;
+    uint8_t gust_idx = 0;
+    uint8_t rainfall_idx = 0;
+    // All combinations of the speeds and rainfall values, so that fields do not overlap.
+    memset(&snapshot, 0, sizeof(SEN15901_snapshot_t));
+    snapshot.direction_status = SEN15901_WIND_DIRECTION_STATUS_UNDEFINED;
+    for (average_idx = 0; average_idx < SEN15901_PAYLOAD_TEST_VALUES_NUMBER; average_idx++) {
+        for (gust_idx = 0; gust_idx < SEN15901_PAYLOAD_TEST_VALUES_NUMBER; gust_idx++) {
+            for (rainfall_idx = 0; rainfall_idx < SEN15901_PAYLOAD_TEST_VALUES_NUMBER; rainfall_idx++) {
+                snapshot.average_speed_mh = _SEN15901_PAYLOAD_TEST_get_value(average_idx, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_RESOLUTION_MH, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS);
+                snapshot.peak_speed_mh = _SEN15901_PAYLOAD_TEST_get_value(gust_idx, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_RESOLUTION_MH, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS);
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+                snapshot.gust_speed_mh = snapshot.peak_speed_mh;
+#endif
+                snapshot.rainfall_um = _SEN15901_PAYLOAD_TEST_get_value(rainfall_idx, SEN15901_DRIVER_PAYLOAD_RAINFALL_RESOLUTION_UM, SEN15901_DRIVER_PAYLOAD_RAINFALL_BITS);
+                status = _SEN15901_PAYLOAD_TEST_round_trip(&snapshot, &decoded_snapshot);
+                if (status != SEN15901_SUCCESS) goto errors;
+#ifdef SEN15901_DRIVER_WIND_GUST_WINDOW_SECONDS
+                decoded_gust_speed_mh = decoded_snapshot.gust_speed_mh;
+#else
+                decoded_gust_speed_mh = decoded_snapshot.peak_speed_mh;
+#endif
+                if ((decoded_snapshot.average_speed_mh != _SEN15901_PAYLOAD_TEST_get_expected(snapshot.average_speed_mh, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_RESOLUTION_MH, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS)) ||
+                    (decoded_gust_speed_mh != _SEN15901_PAYLOAD_TEST_get_expected(snapshot.peak_speed_mh, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_RESOLUTION_MH, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS)) ||
+                    (decoded_snapshot.rainfall_um != _SEN15901_PAYLOAD_TEST_get_expected(snapshot.rainfall_um, SEN15901_DRIVER_PAYLOAD_RAINFALL_RESOLUTION_UM, SEN15901_DRIVER_PAYLOAD_RAINFALL_BITS)) ||
+                    (decoded_snapshot.direction_status != SEN15901_WIND_DIRECTION_STATUS_UNDEFINED)) {
+                    printf("average=%d gust=%d rainfall=%d decoded as average=%d gust=%d rainfall=%d\n", (int) snapshot.average_speed_mh, (int) snapshot.peak_speed_mh, (int) snapshot.rainfall_um,
+                           (int) decoded_snapshot.average_speed_mh, (int) decoded_gust_speed_mh, (int) decoded_snapshot.rainfall_um);
+                    failed_count++;
+                }
+            }
+        }
+    }
+    (*pass) &= _SEN15901_PAYLOAD_TEST_check("speed and rainfall failures", failed_count, 0);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_PAYLOAD_TEST_direction(uint8_t* pass) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_snapshot_t snapshot;
+    SEN15901_snapshot_t decoded_snapshot;
+    int32_t direction_error_degrees = 0;
+    uint32_t failed_count = 0;
+    // Decoded direction is the closest sector (truncated to the degree).
+    memset(&snapshot, 0, sizeof(SEN15901_snapshot_t));
+    snapshot.direction_status = SEN15901_WIND_DIRECTION_STATUS_AVAILABLE;
+    for (snapshot.average_direction_degrees = 0; snapshot.average_direction_degrees < 360; snapshot.average_direction_degrees++) {
+        status = _SEN15901_PAYLOAD_TEST_round_trip(&snapshot, &decoded_snapshot);
+        if (status != SEN15901_SUCCESS) goto errors;
+        direction_error_degrees = (((decoded_snapshot.average_direction_degrees - snapshot.average_direction_degrees) + 540) % 360) - 180;
+        if (direction_error_degrees < 0) {
+            direction_error_degrees = -direction_error_degrees;
+        }
+        if ((decoded_snapshot.direction_status != SEN15901_WIND_DIRECTION_STATUS_AVAILABLE) || (direction_error_degrees > ((180 / SEN15901_PAYLOAD_TEST_DIRECTION_SECTORS_NUMBER) + 1))) {
+            printf("direction=%d decoded as %d\n", (int) snapshot.average_direction_degrees, (int) decoded_snapshot.average_direction_degrees);
+            failed_count++;
+        }
+    }
+    (*pass) &= _SEN15901_PAYLOAD_TEST_check("direction failures", failed_count, 0);
+errors:
+    return status;
+}
+
+/*** SEN15901 PAYLOAD TEST main function ***/
+
+/*******************************************************************/
+int main(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_snapshot_t snapshot;
+    uint8_t payload[SEN15901_PAYLOAD_SIZE_BYTES];
+    uint8_t pass = 1;
+    // Buffer size checks.
+    memset(&snapshot, 0, sizeof(SEN15901_snapshot_t));
+    pass &= _SEN15901_PAYLOAD_TEST_check("encode short buffer", (uint32_t) SEN15901_PAYLOAD_encode(&snapshot, payload, (SEN15901_PAYLOAD_SIZE_BYTES - 1)), (uint32_t) SEN15901_ERROR_PAYLOAD_SIZE);
+    pass &= _SEN15901_PAYLOAD_TEST_check("decode short buffer", (uint32_t) SEN15901_PAYLOAD_decode(payload, (SEN15901_PAYLOAD_SIZE_BYTES - 1), &snapshot), (uint32_t) SEN15901_ERROR_PAYLOAD_SIZE);
+    // All fields at their maximum.
+    memset(payload, 0xFF, sizeof(payload));
+    status = SEN15901_PAYLOAD_decode(payload, SEN15901_PAYLOAD_SIZE_BYTES, &snapshot);
+    if (status != SEN15901_SUCCESS) goto errors;
+    pass &= _SEN15901_PAYLOAD_TEST_check("maximum average speed", (uint32_t) snapshot.average_speed_mh, (uint32_t) _SEN15901_PAYLOAD_TEST_get_maximum(SEN15901_DRIVER_PAYLOAD_WIND_SPEED_RESOLUTION_MH, SEN15901_DRIVER_PAYLOAD_WIND_SPEED_BITS));
+    pass &= _SEN15901_PAYLOAD_TEST_check("maximum rainfall", (uint32_t) snapshot.rainfall_um, (uint32_t) _SEN15901_PAYLOAD_TEST_get_maximum(SEN15901_DRIVER_PAYLOAD_RAINFALL_RESOLUTION_UM, SEN15901_DRIVER_PAYLOAD_RAINFALL_BITS));
+    // Round trips.
+    status = _SEN15901_PAYLOAD_TEST_fields(&pass);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = _SEN15901_PAYLOAD_TEST_direction(&pass);
+    if (status != SEN15901_SUCCESS) goto errors;
+    return (pass != 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+errors:
+    printf("SEN15901 driver error 0x%x\n", (unsigned int) status);
+    return EXIT_FAILURE;
+}
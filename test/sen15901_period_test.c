@@ -0,0 +1,114 @@
+/*
+ * sen15901_period_test.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sen15901.h"
+#include "sen15901_hw_sim.h"
+#include "types.h"
+
+/*** SEN15901 PERIOD TEST local macros ***/
+
+#define SEN15901_PERIOD_TEST_SECONDS_MAX        3600
+
+// Above SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT (count mode) and below (period mode).
+#define SEN15901_PERIOD_TEST_WINDY_EDGES        (SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT * 5)
+#define SEN15901_PERIOD_TEST_SLOW_EDGES         ((SEN15901_DRIVER_WIND_SPEED_PERIOD_MEASUREMENT + 1) / 2)
+
+/*** SEN15901 PERIOD TEST local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    const char* name;
+    uint32_t seconds;
+    uint16_t wind_speed_edge_count;
+} SEN15901_PERIOD_TEST_phase_t;
+
+/*** SEN15901 PERIOD TEST local global variables ***/
+
+// Each phase is closed by a snapshot where the average and peak speeds are those of the constant edges rate.
+static const SEN15901_PERIOD_TEST_phase_t SEN15901_PERIOD_TEST_PHASES[] = {
+    { "windy", 60, SEN15901_PERIOD_TEST_WINDY_EDGES },
+    { "calm", 3600, 0 },
+    { "windy", 60, SEN15901_PERIOD_TEST_WINDY_EDGES },
+    { "slow", 60, SEN15901_PERIOD_TEST_SLOW_EDGES },
+};
+
+static SEN15901_HW_SIM_trace_second_t sen15901_period_test_trace[SEN15901_PERIOD_TEST_SECONDS_MAX];
+
+/*** SEN15901 PERIOD TEST local functions ***/
+
+/*******************************************************************/
+static void _SEN15901_PERIOD_TEST_process_callback(SEN15901_context_t* context) {
+    // Process function is called by the simulator.
+    UNUSED(context);
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_PERIOD_TEST_check(const char* name, uint32_t value, uint32_t reference) {
+    // Local variables.
+    uint8_t pass = (value == reference) ? 1 : 0;
+    // Print result.
+    printf("%-32s %6u (reference %6u) %s\n", name, (unsigned int) value, (unsigned int) reference, (pass != 0) ? "OK" : "FAILED");
+    return pass;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_PERIOD_TEST_run_phase(SEN15901_context_t* context, const SEN15901_PERIOD_TEST_phase_t* phase, uint8_t* pass) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_statistics_t statistics = { 0 };
+    SEN15901_snapshot_t snapshot;
+    uint32_t wind_speed_mh = (((uint32_t) phase->wind_speed_edge_count) * 2400);
+    char name[32];
+    uint32_t idx = 0;
+    // Constant anemometer frequency.
+    for (idx = 0; idx < phase->seconds; idx++) {
+        sen15901_period_test_trace[idx].wind_speed_edge_count = phase->wind_speed_edge_count;
+        sen15901_period_test_trace[idx].rain_edge_count = 0;
+        sen15901_period_test_trace[idx].wind_direction_ratio_permille = 500;
+    }
+    status = SEN15901_HW_SIM_replay(context, sen15901_period_test_trace, phase->seconds, &statistics);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_snapshot(context, &snapshot);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Check speeds.
+    snprintf(name, sizeof(name), "%s average speed (m/h)", phase->name);
+    (*pass) &= _SEN15901_PERIOD_TEST_check(name, (uint32_t) snapshot.average_speed_mh, wind_speed_mh);
+    snprintf(name, sizeof(name), "%s peak speed (m/h)", phase->name);
+    (*pass) &= _SEN15901_PERIOD_TEST_check(name, (uint32_t) snapshot.peak_speed_mh, wind_speed_mh);
+errors:
+    return status;
+}
+
+/*** SEN15901 PERIOD TEST main function ***/
+
+/*******************************************************************/
+int main(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_context_t context;
+    uint8_t phase_idx = 0;
+    uint8_t pass = 1;
+    // Init instance and start wind measurement.
+    status = SEN15901_instance_init(&context, 0, &_SEN15901_PERIOD_TEST_process_callback);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_set_wind_measurement(&context, 1);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Switch between count and period modes.
+    for (phase_idx = 0; phase_idx < (sizeof(SEN15901_PERIOD_TEST_PHASES) / sizeof(SEN15901_PERIOD_TEST_phase_t)); phase_idx++) {
+        status = _SEN15901_PERIOD_TEST_run_phase(&context, &(SEN15901_PERIOD_TEST_PHASES[phase_idx]), &pass);
+        if (status != SEN15901_SUCCESS) goto errors;
+    }
+    status = SEN15901_instance_de_init(&context);
+    if (status != SEN15901_SUCCESS) goto errors;
+    return (pass != 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+errors:
+    printf("SEN15901 driver error 0x%x\n", (unsigned int) status);
+    return EXIT_FAILURE;
+}
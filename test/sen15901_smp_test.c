@@ -0,0 +1,278 @@
+/*
+ * sen15901_smp_test.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sen15901.h"
+#include "sen15901_hw_sim.h"
+#include "types.h"
+
+/*** SEN15901 SMP TEST local macros ***/
+
+#define SEN15901_SMP_TEST_TICKS                 400
+#define SEN15901_SMP_TEST_READERS_NUMBER        2
+
+// Anemometer edges per second once the edges thread is synchronized with the ticks.
+#define SEN15901_SMP_TEST_STEADY_EDGES          50
+// One rain gauge edge every N anemometer edges.
+#define SEN15901_SMP_TEST_RAIN_EDGE_PERIOD      7
+
+#define SEN15901_SMP_TEST_SNAPSHOT_DELAY        20000
+
+/*** SEN15901 SMP TEST local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    SEN15901_context_t context;
+    atomic_uint stop_flag;
+    atomic_uint steady_flag;
+    atomic_uint wind_speed_edge_count;
+    atomic_uint wind_speed_edge_count_processed;
+    atomic_uint rain_edge_count;
+    // Incremented before and after each snapshot, so that odd values mean a snapshot is in progress.
+    atomic_uint snapshot_sequence;
+    atomic_uint steady_snapshot_sequence;
+    atomic_ullong rainfall_um_sum;
+    atomic_uint read_count;
+    atomic_uint torn_read_count;
+    atomic_uint steady_error_count;
+    atomic_uint rainfall_decrease_count;
+    atomic_uint driver_error_count;
+} SEN15901_SMP_TEST_context_t;
+
+/*** SEN15901 SMP TEST local global variables ***/
+
+static SEN15901_SMP_TEST_context_t sen15901_smp_test_ctx;
+
+/*** SEN15901 SMP TEST local functions ***/
+
+/*******************************************************************/
+static void _SEN15901_SMP_TEST_process_callback(SEN15901_context_t* context) {
+    // Process function is called by the ticks thread.
+    UNUSED(context);
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_SMP_TEST_check(const char* name, uint32_t value, uint32_t reference) {
+    // Local variables.
+    uint8_t pass = (value == reference) ? 1 : 0;
+    // Print result.
+    printf("%-32s %6u (reference %6u) %s\n", name, (unsigned int) value, (unsigned int) reference, (pass != 0) ? "OK" : "FAILED");
+    return pass;
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_SMP_TEST_is_blocked(void) {
+    // Local variables.
+    uint32_t edge_count = atomic_load(&(sen15901_smp_test_ctx.wind_speed_edge_count));
+    uint32_t edge_count_processed = atomic_load(&(sen15901_smp_test_ctx.wind_speed_edge_count_processed));
+    // In steady mode, exactly SEN15901_SMP_TEST_STEADY_EDGES edges are generated between two ticks.
+    if (atomic_load(&(sen15901_smp_test_ctx.steady_flag)) == 0) return 0;
+    return (edge_count >= (edge_count_processed + SEN15901_SMP_TEST_STEADY_EDGES)) ? 1 : 0;
+}
+
+/*******************************************************************/
+static void* _SEN15901_SMP_TEST_edges_thread(void* argument) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_statistics_t statistics = { 0 };
+    uint32_t edge_count = 0;
+    UNUSED(argument);
+    // Anemometer and rain gauge interrupts.
+    while (atomic_load(&(sen15901_smp_test_ctx.stop_flag)) == 0) {
+        if (_SEN15901_SMP_TEST_is_blocked() != 0) {
+            sched_yield();
+            continue;
+        }
+        status = SEN15901_HW_SIM_wind_speed_edge(&(sen15901_smp_test_ctx.context), &statistics);
+        if (status != SEN15901_SUCCESS) break;
+        // Edge is counted once its interrupt callback returned.
+        edge_count = (atomic_fetch_add(&(sen15901_smp_test_ctx.wind_speed_edge_count), 1) + 1);
+        if ((edge_count % SEN15901_SMP_TEST_RAIN_EDGE_PERIOD) == 0) {
+            status = SEN15901_HW_SIM_rainfall_edge(&(sen15901_smp_test_ctx.context), &statistics);
+            if (status != SEN15901_SUCCESS) break;
+            atomic_fetch_add(&(sen15901_smp_test_ctx.rain_edge_count), 1);
+        }
+    }
+    if (status != SEN15901_SUCCESS) {
+        atomic_fetch_add(&(sen15901_smp_test_ctx.driver_error_count), 1);
+    }
+    return NULL;
+}
+
+/*******************************************************************/
+static void* _SEN15901_SMP_TEST_ticks_thread(void* argument) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_statistics_t statistics = { 0 };
+    uint32_t tick_idx = 0;
+    UNUSED(argument);
+    // Free running edges during the first half, then steady edges synchronized with the ticks.
+    for (tick_idx = 0; tick_idx < SEN15901_SMP_TEST_TICKS; tick_idx++) {
+        if (tick_idx == (SEN15901_SMP_TEST_TICKS / 2)) {
+            atomic_store(&(sen15901_smp_test_ctx.wind_speed_edge_count_processed), atomic_load(&(sen15901_smp_test_ctx.wind_speed_edge_count)));
+            atomic_store(&(sen15901_smp_test_ctx.steady_flag), 1);
+        }
+        if (tick_idx == ((SEN15901_SMP_TEST_TICKS / 2) + 2)) {
+            // Banks closed by the snapshots started from now only contain steady seconds.
+            atomic_store(&(sen15901_smp_test_ctx.steady_snapshot_sequence), ((atomic_load(&(sen15901_smp_test_ctx.snapshot_sequence)) | 1) + 1));
+        }
+        if (atomic_load(&(sen15901_smp_test_ctx.steady_flag)) != 0) {
+            while (_SEN15901_SMP_TEST_is_blocked() == 0) {
+                sched_yield();
+            }
+        }
+        status = SEN15901_HW_SIM_tick_second(&(sen15901_smp_test_ctx.context), &statistics);
+        if (status != SEN15901_SUCCESS) break;
+        if (atomic_load(&(sen15901_smp_test_ctx.steady_flag)) != 0) {
+            atomic_fetch_add(&(sen15901_smp_test_ctx.wind_speed_edge_count_processed), SEN15901_SMP_TEST_STEADY_EDGES);
+        }
+    }
+    if (status != SEN15901_SUCCESS) {
+        atomic_fetch_add(&(sen15901_smp_test_ctx.driver_error_count), 1);
+    }
+    atomic_store(&(sen15901_smp_test_ctx.stop_flag), 1);
+    return NULL;
+}
+
+/*******************************************************************/
+static void* _SEN15901_SMP_TEST_reader_thread(void* argument) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    int32_t average_speed_mh = 0;
+    int32_t peak_speed_mh = 0;
+    int32_t rainfall_um = 0;
+    int32_t rainfall_um_last = 0;
+    uint32_t snapshot_sequence = 0;
+    uint32_t snapshot_sequence_last = 1;
+    uint32_t steady_snapshot_sequence = 0;
+    UNUSED(argument);
+    // Lock-free getters.
+    while (atomic_load(&(sen15901_smp_test_ctx.stop_flag)) == 0) {
+        snapshot_sequence = atomic_load(&(sen15901_smp_test_ctx.snapshot_sequence));
+        status = SEN15901_instance_get_wind_speed(&(sen15901_smp_test_ctx.context), &average_speed_mh, &peak_speed_mh);
+        if (status != SEN15901_SUCCESS) break;
+        // A reader mixing two updates could see an average above the peak.
+        if (average_speed_mh > peak_speed_mh) {
+            atomic_fetch_add(&(sen15901_smp_test_ctx.torn_read_count), 1);
+        }
+        // With a constant anemometer frequency, the average and the peak are equal.
+        steady_snapshot_sequence = atomic_load(&(sen15901_smp_test_ctx.steady_snapshot_sequence));
+        if ((steady_snapshot_sequence != 0) && (snapshot_sequence >= steady_snapshot_sequence) && (average_speed_mh != peak_speed_mh)) {
+            atomic_fetch_add(&(sen15901_smp_test_ctx.steady_error_count), 1);
+        }
+        status = SEN15901_instance_get_rainfall(&(sen15901_smp_test_ctx.context), &rainfall_um);
+        if (status != SEN15901_SUCCESS) break;
+        // Rainfall can only increase between two snapshots.
+        if (((snapshot_sequence & 1) == 0) && (snapshot_sequence == snapshot_sequence_last) && (snapshot_sequence == atomic_load(&(sen15901_smp_test_ctx.snapshot_sequence))) && (rainfall_um < rainfall_um_last)) {
+            atomic_fetch_add(&(sen15901_smp_test_ctx.rainfall_decrease_count), 1);
+        }
+        rainfall_um_last = rainfall_um;
+        snapshot_sequence_last = snapshot_sequence;
+        atomic_fetch_add(&(sen15901_smp_test_ctx.read_count), 1);
+    }
+    if (status != SEN15901_SUCCESS) {
+        atomic_fetch_add(&(sen15901_smp_test_ctx.driver_error_count), 1);
+    }
+    return NULL;
+}
+
+/*******************************************************************/
+static void* _SEN15901_SMP_TEST_snapshot_thread(void* argument) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_snapshot_t snapshot;
+    volatile uint32_t delay_idx = 0;
+    UNUSED(argument);
+    // Periodic reports, concurrent with the process function.
+    while (atomic_load(&(sen15901_smp_test_ctx.stop_flag)) == 0) {
+        for (delay_idx = 0; delay_idx < SEN15901_SMP_TEST_SNAPSHOT_DELAY; delay_idx++);
+        atomic_fetch_add(&(sen15901_smp_test_ctx.snapshot_sequence), 1);
+        status = SEN15901_instance_snapshot(&(sen15901_smp_test_ctx.context), &snapshot);
+        atomic_fetch_add(&(sen15901_smp_test_ctx.snapshot_sequence), 1);
+        if (status != SEN15901_SUCCESS) break;
+        atomic_fetch_add(&(sen15901_smp_test_ctx.rainfall_um_sum), (uint64_t) snapshot.rainfall_um);
+    }
+    if (status != SEN15901_SUCCESS) {
+        atomic_fetch_add(&(sen15901_smp_test_ctx.driver_error_count), 1);
+    }
+    return NULL;
+}
+
+/*** SEN15901 SMP TEST main function ***/
+
+/*******************************************************************/
+int main(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_snapshot_t snapshot;
+    pthread_t edges_thread;
+    pthread_t ticks_thread;
+    pthread_t snapshot_thread;
+    pthread_t reader_thread[SEN15901_SMP_TEST_READERS_NUMBER];
+    uint64_t rainfall_um = 0;
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+    SEN15901_instrumentation_t instrumentation;
+#endif
+    uint8_t idx = 0;
+    uint8_t pass = 1;
+    // Init driver.
+    status = SEN15901_instance_init(&(sen15901_smp_test_ctx.context), 0, &_SEN15901_SMP_TEST_process_callback);
+    if (status != SEN15901_SUCCESS) goto errors;
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+    // Simulated edges all have the same timestamp.
+    status = SEN15901_instance_set_debounce(&(sen15901_smp_test_ctx.context), 0, 0);
+    if (status != SEN15901_SUCCESS) goto errors;
+#endif
+    status = SEN15901_instance_set_wind_measurement(&(sen15901_smp_test_ctx.context), 1);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_set_rainfall_measurement(&(sen15901_smp_test_ctx.context), 1);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Run interrupts, process function, getters and snapshots on different threads.
+    pthread_create(&edges_thread, NULL, &_SEN15901_SMP_TEST_edges_thread, NULL);
+    pthread_create(&ticks_thread, NULL, &_SEN15901_SMP_TEST_ticks_thread, NULL);
+    pthread_create(&snapshot_thread, NULL, &_SEN15901_SMP_TEST_snapshot_thread, NULL);
+    for (idx = 0; idx < SEN15901_SMP_TEST_READERS_NUMBER; idx++) {
+        pthread_create(&(reader_thread[idx]), NULL, &_SEN15901_SMP_TEST_reader_thread, NULL);
+    }
+    pthread_join(edges_thread, NULL);
+    pthread_join(ticks_thread, NULL);
+    pthread_join(snapshot_thread, NULL);
+    for (idx = 0; idx < SEN15901_SMP_TEST_READERS_NUMBER; idx++) {
+        pthread_join(reader_thread[idx], NULL);
+    }
+    // Close the last interval.
+    status = SEN15901_instance_snapshot(&(sen15901_smp_test_ctx.context), &snapshot);
+    if (status != SEN15901_SUCCESS) goto errors;
+    rainfall_um = (atomic_load(&(sen15901_smp_test_ctx.rainfall_um_sum)) + ((uint64_t) snapshot.rainfall_um));
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+    status = SEN15901_instance_get_instrumentation(&(sen15901_smp_test_ctx.context), &instrumentation);
+    if (status != SEN15901_SUCCESS) goto errors;
+#endif
+    status = SEN15901_instance_de_init(&(sen15901_smp_test_ctx.context));
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Print counters.
+    printf("%u snapshots, %u reads, %u anemometer edges\n", (unsigned int) (atomic_load(&(sen15901_smp_test_ctx.snapshot_sequence)) / 2), (unsigned int) atomic_load(&(sen15901_smp_test_ctx.read_count)), (unsigned int) atomic_load(&(sen15901_smp_test_ctx.wind_speed_edge_count)));
+    // Check results.
+    pass &= _SEN15901_SMP_TEST_check("driver errors", atomic_load(&(sen15901_smp_test_ctx.driver_error_count)), 0);
+    pass &= _SEN15901_SMP_TEST_check("torn wind speed reads", atomic_load(&(sen15901_smp_test_ctx.torn_read_count)), 0);
+    pass &= _SEN15901_SMP_TEST_check("steady wind speed errors", atomic_load(&(sen15901_smp_test_ctx.steady_error_count)), 0);
+    pass &= _SEN15901_SMP_TEST_check("rainfall decreases", atomic_load(&(sen15901_smp_test_ctx.rainfall_decrease_count)), 0);
+    pass &= _SEN15901_SMP_TEST_check("rainfall um", (uint32_t) rainfall_um, (uint32_t) (atomic_load(&(sen15901_smp_test_ctx.rain_edge_count)) * SEN15901_RAIN_EDGE_TO_UM));
+#ifdef SEN15901_DRIVER_INSTRUMENTATION
+    pass &= _SEN15901_SMP_TEST_check("anemometer interrupts", instrumentation.wind_speed_edge_irq_count, atomic_load(&(sen15901_smp_test_ctx.wind_speed_edge_count)));
+    pass &= _SEN15901_SMP_TEST_check("rain gauge interrupts", instrumentation.rainfall_edge_irq_count, atomic_load(&(sen15901_smp_test_ctx.rain_edge_count)));
+#endif
+    return (pass != 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+errors:
+    printf("SEN15901 driver error 0x%x\n", (unsigned int) status);
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,234 @@
+/*
+ * sen15901_tickless_test.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sen15901.h"
+#include "sen15901_hw_sim.h"
+#include "types.h"
+
+/*** SEN15901 TICKLESS TEST local macros ***/
+
+#define SEN15901_TICKLESS_TEST_SECONDS_MAX      3600
+
+// Delay of the wake-up timer running before the first edge (1 second timer started by the edge otherwise).
+#ifdef SEN15901_DRIVER_AGGREGATION
+#define SEN15901_TICKLESS_TEST_TIMER_SECONDS    60
+#else
+#define SEN15901_TICKLESS_TEST_TIMER_SECONDS    1
+#endif
+
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+// Twice the storm detection threshold of the wake-up period, the input is masked until its end.
+#define SEN15901_TICKLESS_TEST_STORM_EDGES      ((4000000 / SEN15901_DRIVER_RAINFALL_DEBOUNCE_US) * SEN15901_TICKLESS_TEST_TIMER_SECONDS * 2)
+#define SEN15901_TICKLESS_TEST_TIPS_SECONDS     119
+#define SEN15901_TICKLESS_TEST_TIPS_COUNTED     (SEN15901_TICKLESS_TEST_TIPS_SECONDS - (SEN15901_TICKLESS_TEST_TIMER_SECONDS - 1))
+#endif
+
+#if ((defined SEN15901_DRIVER_RAIN_RATE_RING_SIZE) || (defined SEN15901_DRIVER_AGGREGATION))
+#define SEN15901_TICKLESS_TEST_SHOWER_TIPS      10
+#endif
+
+/*** SEN15901 TICKLESS TEST local structures ***/
+
+#if ((defined SEN15901_DRIVER_RAIN_RATE_RING_SIZE) || (defined SEN15901_DRIVER_AGGREGATION))
+/*******************************************************************/
+typedef struct {
+    uint32_t seconds;
+    // Expected value of each rain rate window or aggregation level.
+    int32_t value[3];
+} SEN15901_TICKLESS_TEST_step_t;
+#endif
+
+/*** SEN15901 TICKLESS TEST local global variables ***/
+
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+// Dry periods following the shower (timestamped at the end of the wake-up period), with the expected rates of the 1, 10 and 60 minutes windows.
+static const SEN15901_TICKLESS_TEST_step_t SEN15901_TICKLESS_TEST_RAIN_RATE_STEPS[] = {
+    { (30 + SEN15901_TICKLESS_TEST_TIMER_SECONDS - 1), { (SEN15901_TICKLESS_TEST_SHOWER_TIPS * SEN15901_RAIN_EDGE_TO_UM * 60), (SEN15901_TICKLESS_TEST_SHOWER_TIPS * SEN15901_RAIN_EDGE_TO_UM * 6), (SEN15901_TICKLESS_TEST_SHOWER_TIPS * SEN15901_RAIN_EDGE_TO_UM) } },
+    { 60, { 0, (SEN15901_TICKLESS_TEST_SHOWER_TIPS * SEN15901_RAIN_EDGE_TO_UM * 6), (SEN15901_TICKLESS_TEST_SHOWER_TIPS * SEN15901_RAIN_EDGE_TO_UM) } },
+    { 600, { 0, 0, (SEN15901_TICKLESS_TEST_SHOWER_TIPS * SEN15901_RAIN_EDGE_TO_UM) } },
+    { 3000, { 0, 0, 0 } },
+};
+#endif
+
+#ifdef SEN15901_DRIVER_AGGREGATION
+// Dry periods following the shower, with the expected rainfall of the last completed 1 minute, 10 minutes and 1 hour intervals.
+static const SEN15901_TICKLESS_TEST_step_t SEN15901_TICKLESS_TEST_AGGREGATION_STEPS[] = {
+    { 59, { (SEN15901_TICKLESS_TEST_SHOWER_TIPS * SEN15901_RAIN_EDGE_TO_UM), 0, 0 } },
+    { 60, { 0, 0, 0 } },
+    { 480, { 0, (SEN15901_TICKLESS_TEST_SHOWER_TIPS * SEN15901_RAIN_EDGE_TO_UM), 0 } },
+    { 3000, { 0, 0, (SEN15901_TICKLESS_TEST_SHOWER_TIPS * SEN15901_RAIN_EDGE_TO_UM) } },
+};
+#endif
+
+static SEN15901_HW_SIM_trace_second_t sen15901_tickless_test_trace[SEN15901_TICKLESS_TEST_SECONDS_MAX];
+
+/*** SEN15901 TICKLESS TEST local functions ***/
+
+/*******************************************************************/
+static void _SEN15901_TICKLESS_TEST_process_callback(SEN15901_context_t* context) {
+    // Process function is called by the simulator.
+    UNUSED(context);
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_TICKLESS_TEST_check(const char* name, uint32_t value, uint32_t reference) {
+    // Local variables.
+    uint8_t pass = (value == reference) ? 1 : 0;
+    // Print result.
+    printf("%-32s %6u (reference %6u) %s\n", name, (unsigned int) value, (unsigned int) reference, (pass != 0) ? "OK" : "FAILED");
+    return pass;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_TICKLESS_TEST_replay_rain(SEN15901_context_t* context, uint32_t seconds, uint16_t rain_edge_count) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_HW_SIM_statistics_t statistics = { 0 };
+    uint32_t idx = 0;
+    // Constant rain gauge frequency without wind.
+    for (idx = 0; idx < seconds; idx++) {
+        sen15901_tickless_test_trace[idx].wind_speed_edge_count = 0;
+        sen15901_tickless_test_trace[idx].rain_edge_count = rain_edge_count;
+        sen15901_tickless_test_trace[idx].wind_direction_ratio_permille = 500;
+    }
+    status = SEN15901_HW_SIM_replay(context, sen15901_tickless_test_trace, seconds, &statistics);
+    return status;
+}
+
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_TICKLESS_TEST_storm(uint8_t* pass) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_context_t context;
+    SEN15901_snapshot_t snapshot;
+    SEN15901_edge_guard_events_t events;
+    // Rain gauge only, the wake-up timer is stopped or runs on the aggregation minutes.
+    status = SEN15901_instance_init(&context, 0, &_SEN15901_TICKLESS_TEST_process_callback);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_set_rainfall_measurement(&context, 1);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Storm: the input is masked.
+    status = _SEN15901_TICKLESS_TEST_replay_rain(&context, 1, SEN15901_TICKLESS_TEST_STORM_EDGES);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_snapshot(&context, &snapshot);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Regular tips: the input must have been unmasked by the next tick.
+    status = _SEN15901_TICKLESS_TEST_replay_rain(&context, SEN15901_TICKLESS_TEST_TIPS_SECONDS, 1);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_snapshot(&context, &snapshot);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_get_edge_guard_events(&context, &events);
+    if (status != SEN15901_SUCCESS) goto errors;
+    (*pass) &= _SEN15901_TICKLESS_TEST_check("storm rainfall (um)", (uint32_t) snapshot.rainfall_um, (SEN15901_TICKLESS_TEST_TIPS_COUNTED * SEN15901_RAIN_EDGE_TO_UM));
+    (*pass) &= _SEN15901_TICKLESS_TEST_check("storm events", events.rainfall_storm_count, 1);
+    status = SEN15901_instance_de_init(&context);
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_TICKLESS_TEST_rain_rate(uint8_t* pass) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_context_t context;
+    int32_t rain_rate_um_h = 0;
+    char name[32];
+    uint8_t step_idx = 0;
+    uint8_t window = 0;
+    // Rain gauge only, the wake-up timer is stopped or runs on the aggregation minutes.
+    status = SEN15901_instance_init(&context, 0, &_SEN15901_TICKLESS_TEST_process_callback);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_set_rainfall_measurement(&context, 1);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Short shower.
+    status = _SEN15901_TICKLESS_TEST_replay_rain(&context, 1, SEN15901_TICKLESS_TEST_SHOWER_TIPS);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // The tips must expire from each window without any edge.
+    for (step_idx = 0; step_idx < (sizeof(SEN15901_TICKLESS_TEST_RAIN_RATE_STEPS) / sizeof(SEN15901_TICKLESS_TEST_step_t)); step_idx++) {
+        status = _SEN15901_TICKLESS_TEST_replay_rain(&context, SEN15901_TICKLESS_TEST_RAIN_RATE_STEPS[step_idx].seconds, 0);
+        if (status != SEN15901_SUCCESS) goto errors;
+        for (window = 0; window < SEN15901_RAIN_RATE_WINDOW_LAST; window++) {
+            status = SEN15901_instance_get_rain_rate(&context, window, &rain_rate_um_h);
+            if (status != SEN15901_SUCCESS) goto errors;
+            snprintf(name, sizeof(name), "step %u window %u rate (um/h)", step_idx, window);
+            (*pass) &= _SEN15901_TICKLESS_TEST_check(name, (uint32_t) rain_rate_um_h, (uint32_t) SEN15901_TICKLESS_TEST_RAIN_RATE_STEPS[step_idx].value[window]);
+        }
+    }
+    status = SEN15901_instance_de_init(&context);
+errors:
+    return status;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_AGGREGATION
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_TICKLESS_TEST_aggregation(uint8_t* pass) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_context_t context;
+    SEN15901_snapshot_t snapshot;
+    char name[32];
+    uint8_t step_idx = 0;
+    uint8_t level = 0;
+    // Rain gauge only, the wake-up timer runs on the minutes boundaries.
+    status = SEN15901_instance_init(&context, 0, &_SEN15901_TICKLESS_TEST_process_callback);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_set_rainfall_measurement(&context, 1);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Short shower in the first minute.
+    status = _SEN15901_TICKLESS_TEST_replay_rain(&context, 1, SEN15901_TICKLESS_TEST_SHOWER_TIPS);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Each level must be closed without wind measurement.
+    for (step_idx = 0; step_idx < (sizeof(SEN15901_TICKLESS_TEST_AGGREGATION_STEPS) / sizeof(SEN15901_TICKLESS_TEST_step_t)); step_idx++) {
+        status = _SEN15901_TICKLESS_TEST_replay_rain(&context, SEN15901_TICKLESS_TEST_AGGREGATION_STEPS[step_idx].seconds, 0);
+        if (status != SEN15901_SUCCESS) goto errors;
+        for (level = 0; level < SEN15901_AGGREGATION_LEVEL_LAST; level++) {
+            status = SEN15901_instance_get_aggregate(&context, level, &snapshot);
+            if (status != SEN15901_SUCCESS) goto errors;
+            snprintf(name, sizeof(name), "step %u level %u rainfall (um)", step_idx, level);
+            (*pass) &= _SEN15901_TICKLESS_TEST_check(name, (uint32_t) snapshot.rainfall_um, (uint32_t) SEN15901_TICKLESS_TEST_AGGREGATION_STEPS[step_idx].value[level]);
+        }
+    }
+    status = SEN15901_instance_de_init(&context);
+errors:
+    return status;
+}
+#endif
+
+/*** SEN15901 TICKLESS TEST main function ***/
+
+/*******************************************************************/
+int main(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint8_t pass = 1;
+#ifdef SEN15901_DRIVER_EDGE_DEBOUNCE
+    // Masked input while wind measurement is disabled.
+    status = _SEN15901_TICKLESS_TEST_storm(&pass);
+    if (status != SEN15901_SUCCESS) goto errors;
+#endif
+#ifdef SEN15901_DRIVER_RAIN_RATE_RING_SIZE
+    // Rain rate windows expiry while wind measurement is disabled.
+    status = _SEN15901_TICKLESS_TEST_rain_rate(&pass);
+    if (status != SEN15901_SUCCESS) goto errors;
+#endif
+#ifdef SEN15901_DRIVER_AGGREGATION
+    // Aggregation levels closing while wind measurement is disabled.
+    status = _SEN15901_TICKLESS_TEST_aggregation(&pass);
+    if (status != SEN15901_SUCCESS) goto errors;
+#endif
+    return (pass != 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+errors:
+    printf("SEN15901 driver error 0x%x\n", (unsigned int) status);
+    return EXIT_FAILURE;
+}
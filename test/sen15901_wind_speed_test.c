@@ -0,0 +1,171 @@
+/*
+ * sen15901_wind_speed_test.c
+ *
+ *  Created on: 17 oct. 2026
+ *      Author: Ludo
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sen15901.h"
+#include "sen15901_hw_sim.h"
+#include "types.h"
+
+/*** SEN15901 WIND SPEED TEST local macros ***/
+
+#define SEN15901_WIND_SPEED_TEST_DAYS               5
+#define SEN15901_WIND_SPEED_TEST_DAY_SECONDS        86400
+#define SEN15901_WIND_SPEED_TEST_TRACE_SIZE         (SEN15901_WIND_SPEED_TEST_DAYS * SEN15901_WIND_SPEED_TEST_DAY_SECONDS)
+
+#define SEN15901_WIND_SPEED_TEST_EDGES_MAX          80
+
+/*** SEN15901 WIND SPEED TEST local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    double wind_speed_mh_sum;
+    uint32_t wind_speed_data_count;
+    uint32_t peak_speed_mh;
+} SEN15901_WIND_SPEED_TEST_reference_t;
+
+/*** SEN15901 WIND SPEED TEST local global variables ***/
+
+static SEN15901_HW_SIM_trace_second_t sen15901_wind_speed_test_trace[SEN15901_WIND_SPEED_TEST_TRACE_SIZE];
+
+/*** SEN15901 WIND SPEED TEST local functions ***/
+
+/*******************************************************************/
+static uint32_t _SEN15901_WIND_SPEED_TEST_random(uint32_t* seed) {
+    // Portable linear congruential generator, so that the trace is the same on all hosts.
+    (*seed) = (((*seed) * 1664525) + 1013904223);
+    return ((*seed) >> 8);
+}
+
+/*******************************************************************/
+static void _SEN15901_WIND_SPEED_TEST_process_callback(SEN15901_context_t* context) {
+    // Process function is called by the simulator.
+    UNUSED(context);
+}
+
+/*******************************************************************/
+static void _SEN15901_WIND_SPEED_TEST_build_trace(void) {
+    // Local variables.
+    uint32_t seed = 7;
+    uint32_t second_idx = 0;
+    uint32_t wind_speed_edge_count = 0;
+    SEN15901_HW_SIM_trace_second_t* second = NULL;
+    // Random walk of the anemometer frequency with occasional gusts.
+    for (second_idx = 0; second_idx < SEN15901_WIND_SPEED_TEST_TRACE_SIZE; second_idx++) {
+        wind_speed_edge_count = ((wind_speed_edge_count + 3) > (_SEN15901_WIND_SPEED_TEST_random(&seed) % 7)) ? ((wind_speed_edge_count + 3) - (_SEN15901_WIND_SPEED_TEST_random(&seed) % 7)) : 0;
+        if (wind_speed_edge_count > (SEN15901_WIND_SPEED_TEST_EDGES_MAX / 2)) {
+            wind_speed_edge_count = (SEN15901_WIND_SPEED_TEST_EDGES_MAX / 2);
+        }
+        second = &(sen15901_wind_speed_test_trace[second_idx]);
+        second->wind_speed_edge_count = (uint16_t) wind_speed_edge_count;
+        if ((_SEN15901_WIND_SPEED_TEST_random(&seed) % 1000) == 0) {
+            second->wind_speed_edge_count = SEN15901_WIND_SPEED_TEST_EDGES_MAX;
+        }
+        second->rain_edge_count = 0;
+        second->wind_direction_ratio_permille = 500;
+    }
+}
+
+/*******************************************************************/
+static void _SEN15901_WIND_SPEED_TEST_compute_reference(uint32_t first_second, uint32_t seconds_count, SEN15901_WIND_SPEED_TEST_reference_t* reference) {
+    // Local variables.
+    uint32_t window_start = 0;
+    uint32_t wind_speed_edge_count = 0;
+    uint32_t wind_speed_mh = 0;
+    uint32_t idx = 0;
+    // Sampling windows ending in the interval (windows are not restarted by the snapshots).
+    reference->wind_speed_mh_sum = 0.0;
+    reference->wind_speed_data_count = 0;
+    reference->peak_speed_mh = 0;
+    for (window_start = ((first_second / SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS) * SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS); (window_start + SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS) <= (first_second + seconds_count); window_start += SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS) {
+        wind_speed_edge_count = 0;
+        for (idx = 0; idx < SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS; idx++) {
+            wind_speed_edge_count += sen15901_wind_speed_test_trace[window_start + idx].wind_speed_edge_count;
+        }
+        // Exact mean of the real speeds, the driver only truncates the sampled speeds and the final division.
+        reference->wind_speed_mh_sum += (((double) wind_speed_edge_count) * 2400.0) / ((double) SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS);
+        reference->wind_speed_data_count++;
+        wind_speed_mh = ((wind_speed_edge_count * 2400) / SEN15901_DRIVER_WIND_SPEED_SAMPLING_TIME_SECONDS);
+        if (wind_speed_mh > reference->peak_speed_mh) {
+            reference->peak_speed_mh = wind_speed_mh;
+        }
+    }
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_WIND_SPEED_TEST_check(const char* name, SEN15901_snapshot_t* snapshot, SEN15901_WIND_SPEED_TEST_reference_t* reference) {
+    // Local variables.
+    double average_speed_mh = (reference->wind_speed_mh_sum / ((double) reference->wind_speed_data_count));
+    double error_mh = (((double) snapshot->average_speed_mh) - average_speed_mh);
+    // Truncation of the samples and of the mean are both below 1 m/h.
+    uint8_t pass = ((error_mh <= 0.0) && (error_mh > -2.0) && (((uint32_t) snapshot->peak_speed_mh) == reference->peak_speed_mh)) ? 1 : 0;
+    // Print result.
+    printf("%-8s samples=%-7u average=%-6d (reference %.3f) peak=%-6d (reference %u) %s\n", name, (unsigned int) reference->wind_speed_data_count, (int) snapshot->average_speed_mh, average_speed_mh, (int) snapshot->peak_speed_mh, (unsigned int) reference->peak_speed_mh, (pass != 0) ? "OK" : "FAILED");
+    return pass;
+}
+
+/*******************************************************************/
+static SEN15901_status_t _SEN15901_WIND_SPEED_TEST_start(SEN15901_context_t* context, uint8_t hw_instance) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    // Init instance and start wind measurement.
+    status = SEN15901_instance_init(context, hw_instance, &_SEN15901_WIND_SPEED_TEST_process_callback);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_set_wind_measurement(context, 1);
+    if (status != SEN15901_SUCCESS) goto errors;
+errors:
+    return status;
+}
+
+/*** SEN15901 WIND SPEED TEST main function ***/
+
+/*******************************************************************/
+int main(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    SEN15901_context_t daily_context;
+    SEN15901_context_t full_context;
+    SEN15901_HW_SIM_statistics_t statistics = { 0 };
+    SEN15901_WIND_SPEED_TEST_reference_t reference;
+    SEN15901_snapshot_t snapshot;
+    char name[16];
+    uint32_t day_idx = 0;
+    uint8_t pass = 1;
+    // Build trace.
+    _SEN15901_WIND_SPEED_TEST_build_trace();
+    // Daily reports.
+    status = _SEN15901_WIND_SPEED_TEST_start(&daily_context, 0);
+    if (status != SEN15901_SUCCESS) goto errors;
+    for (day_idx = 0; day_idx < SEN15901_WIND_SPEED_TEST_DAYS; day_idx++) {
+        status = SEN15901_HW_SIM_replay(&daily_context, &(sen15901_wind_speed_test_trace[day_idx * SEN15901_WIND_SPEED_TEST_DAY_SECONDS]), SEN15901_WIND_SPEED_TEST_DAY_SECONDS, &statistics);
+        if (status != SEN15901_SUCCESS) goto errors;
+        status = SEN15901_instance_snapshot(&daily_context, &snapshot);
+        if (status != SEN15901_SUCCESS) goto errors;
+        _SEN15901_WIND_SPEED_TEST_compute_reference((day_idx * SEN15901_WIND_SPEED_TEST_DAY_SECONDS), SEN15901_WIND_SPEED_TEST_DAY_SECONDS, &reference);
+        snprintf(name, sizeof(name), "day %u", (unsigned int) (day_idx + 1));
+        pass &= _SEN15901_WIND_SPEED_TEST_check(name, &snapshot, &reference);
+    }
+    status = SEN15901_instance_de_init(&daily_context);
+    if (status != SEN15901_SUCCESS) goto errors;
+    // Single report over all days.
+    status = _SEN15901_WIND_SPEED_TEST_start(&full_context, 1);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_HW_SIM_replay(&full_context, sen15901_wind_speed_test_trace, SEN15901_WIND_SPEED_TEST_TRACE_SIZE, &statistics);
+    if (status != SEN15901_SUCCESS) goto errors;
+    status = SEN15901_instance_snapshot(&full_context, &snapshot);
+    if (status != SEN15901_SUCCESS) goto errors;
+    _SEN15901_WIND_SPEED_TEST_compute_reference(0, SEN15901_WIND_SPEED_TEST_TRACE_SIZE, &reference);
+    pass &= _SEN15901_WIND_SPEED_TEST_check("all days", &snapshot, &reference);
+    status = SEN15901_instance_de_init(&full_context);
+    if (status != SEN15901_SUCCESS) goto errors;
+    return (pass != 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+errors:
+    printf("SEN15901 driver error 0x%x\n", (unsigned int) status);
+    return EXIT_FAILURE;
+}